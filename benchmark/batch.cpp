@@ -0,0 +1,87 @@
+#include "optimizer/optimizer.hpp"
+#include "interval/packed.hpp"
+
+#include <iostream>
+#include <string>
+
+using namespace rapidlab;
+
+// Test functions of test/optimizer.test.cpp, one box and a block at a time
+interval rosenbrock2d(const box<2>& b) {
+    return 100 * sqr(b[1] - sqr(b[0])) + sqr(b[0] - 1);
+}
+
+void rosenbrock2d_batch(const box_block<2>& b, interval* result) {
+    for (size_t k = 0; k < b.size(); ++k) {
+        result[k] = 100 * sqr(b[1][k] - sqr(b[0][k])) + sqr(b[0][k] - 1);
+    }
+}
+
+void rosenbrock2d_packed(const box_block<2>& b, interval* result) {
+    for (size_t k = 0; k < b.size(); k += interval_x4::size) {
+        interval_x4 x0(b[0] + k), x1(b[1] + k);
+        interval_x4 r = 100 * sqr(x1 - sqr(x0)) + sqr(x0 - 1);
+        r.store(result + k);
+    }
+}
+
+interval bukin_no6(const box<2>& b) {
+    return 100 * sqrt(abs(b[1] - 0.01 * sqr(b[0]))) + 0.01 * abs(b[0] + 10);
+}
+
+void bukin_no6_batch(const box_block<2>& b, interval* result) {
+    for (size_t k = 0; k < b.size(); ++k) {
+        result[k] = 100 * sqrt(abs(b[1][k] - 0.01 * sqr(b[0][k]))) +
+            0.01 * abs(b[0][k] + 10);
+    }
+}
+
+void bukin_no6_packed(const box_block<2>& b, interval* result) {
+    for (size_t k = 0; k < b.size(); k += interval_x4::size) {
+        interval_x4 x0(b[0] + k), x1(b[1] + k);
+        interval_x4 r = 100 * sqrt(abs(x1 - 0.01 * sqr(x0))) +
+            0.01 * abs(x0 + 10);
+        r.store(result + k);
+    }
+}
+
+void run(const std::string& name,
+         optimizer<2>::func_t f, optimizer<2>::func_batch_t f_batch,
+         optimizer<2>::func_batch_t f_packed,
+         const box<2>& b0, double epsilon) {
+    options_t o;
+    o.epsilon = epsilon;
+
+    optimizer<2> scalar(f, o);
+    scalar.solve(b0);
+    double scalar_rate = scalar.box_count() / scalar.time();
+
+    optimizer<2> batched(f, o);
+    batched.set_batch_function(f_batch);
+    batched.solve(b0);
+    double batch_rate = batched.box_count() / batched.time();
+
+    optimizer<2> packed(f, o);
+    packed.set_batch_function(f_packed);
+    packed.solve(b0);
+    double packed_rate = packed.box_count() / packed.time();
+
+    std::cout << name << "\n"
+              << "  scalar  " << scalar.box_count() << " boxes in "
+              << scalar.time() << " s, " << scalar_rate << " boxes/s\n"
+              << "  batched " << batched.box_count() << " boxes in "
+              << batched.time() << " s, " << batch_rate << " boxes/s\n"
+              << "  packed  " << packed.box_count() << " boxes in "
+              << packed.time() << " s, " << packed_rate << " boxes/s\n"
+              << "  throughput ratio batched " << batch_rate / scalar_rate
+              << ", packed " << packed_rate / scalar_rate << "\n";
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    run("rosenbrock2d", rosenbrock2d, rosenbrock2d_batch, rosenbrock2d_packed,
+        box<2>({interval(0,2), interval(-1,1.5)}), 1e-6);
+    run("bukin_no6", bukin_no6, bukin_no6_batch, bukin_no6_packed,
+        box<2>({interval(-15,-5), interval(-3,3)}), 1e-6);
+}
@@ -1,7 +1,6 @@
 #include <iostream>
-#include <interval/arithmetic.hpp>
+#include <interval/core.hpp>
 #include <interval/box.hpp>
-#include <interval/io.hpp>
 
 #include <boost/numeric/interval.hpp>
 #include <boost/timer.hpp>
@@ -0,0 +1,75 @@
+#include "optimizer/optimizer.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace rapidlab;
+
+// Test function of test/optimizer.test.cpp with its derivatives. Every box
+// calls the objective or a derivative five times, each an indirect call
+// through std::function unless the callables are given directly.
+interval rosenbrock2d(const box<2>& b) {
+    return 100 * sqr(b[1] - sqr(b[0])) + sqr(b[0] - 1);
+}
+
+std::array<interval, 2> rosenbrock2d_d(const box<2>& b) {
+    std::array<interval, 2> s;
+    s[1] = 200 * (b[1] - sqr(b[0]));
+    s[0] = (1 - s[1]) * 2 * b[0] - 2;
+    return s;
+}
+
+Eigen::Matrix<interval, 2, 2> rosenbrock2d_dd(const box<2>& b) {
+    Eigen::Matrix<interval, 2, 2> s;
+    s(0,0) = -400 * b[0] * -2 * b[0] + -400 * (b[1] - sqr(b[0])) + 2;
+    s(1,1) = 200;
+    s(0,1) = -400 * b[0];
+    s(1,0) = s(0,1);
+    return s;
+}
+
+// Best time per box of several solves
+template <class opt_t>
+double time_per_box(opt_t& opt, const box<2>& b0, int64_t& boxes) {
+    double best = INFINITY;
+    for (int k = 0; k < 50; ++k) {
+        opt.solve(b0);
+        best = std::min(best, opt.time() / opt.box_count());
+    }
+    boxes = opt.box_count();
+    return best;
+}
+
+template <class opt_t>
+void run(const std::string& name, optimizer<2>& erased, opt_t& direct,
+         const box<2>& b0) {
+    int64_t erased_boxes, direct_boxes;
+    double erased_time = time_per_box(erased, b0, erased_boxes);
+    double direct_time = time_per_box(direct, b0, direct_boxes);
+
+    std::cout << name << "\n"
+              << "  std::function " << erased_boxes << " boxes, "
+              << erased_time * 1e9 << " ns/box\n"
+              << "  callable      " << direct_boxes << " boxes, "
+              << direct_time * 1e9 << " ns/box\n"
+              << "  overhead removed " << (erased_time - direct_time) * 1e9
+              << " ns/box\n";
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    options_t o;
+    o.epsilon = 1e-6;
+
+    box<2> rosenbrock_box({interval(-5,5), interval(-5,5)});
+    optimizer<2> erased_rosenbrock(
+        rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+    auto direct_rosenbrock = make_optimizer<2>(
+        [](const box<2>& b) { return rosenbrock2d(b); },
+        [](const box<2>& b) { return rosenbrock2d_d(b); },
+        [](const box<2>& b) { return rosenbrock2d_dd(b); }, o);
+    run("rosenbrock2d, first and second derivative",
+        erased_rosenbrock, direct_rosenbrock, rosenbrock_box);
+}
@@ -0,0 +1,115 @@
+#include "optimizer/optimizer.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace rapidlab;
+
+// Sum of sin(x_i) exp(x_{i+1} / 10) in 6 dimensions with a quadratic
+// term. Value, gradient and Hessian all need the sines, cosines and
+// exponentials, which separate callbacks evaluate once each and the
+// combined callback once per box.
+const size_t N = 6;
+
+interval coupled(const box<N>& b) {
+    interval r(0);
+    for (size_t i = 0; i < N; ++i) {
+        if (i + 1 < N) r += sin(b[i]) * exp(b[i + 1] / 10);
+        r += sqr(b[i]) / 20;
+    }
+    return r;
+}
+
+std::array<interval, N> coupled_d(const box<N>& b) {
+    std::array<interval, N> g;
+    for (size_t i = 0; i < N; ++i) {
+        g[i] = b[i] / 10;
+        if (i + 1 < N) g[i] += cos(b[i]) * exp(b[i + 1] / 10);
+        if (i > 0) g[i] += sin(b[i - 1]) * exp(b[i] / 10) / 10;
+    }
+    return g;
+}
+
+Eigen::Matrix<interval, N, N> coupled_dd(const box<N>& b) {
+    Eigen::Matrix<interval, N, N> h;
+    h.fill(interval(0));
+    for (size_t i = 0; i < N; ++i) {
+        h(i,i) = interval(0.1);
+        if (i + 1 < N) {
+            h(i,i) -= sin(b[i]) * exp(b[i + 1] / 10);
+            h(i,i + 1) = cos(b[i]) * exp(b[i + 1] / 10) / 10;
+            h(i + 1,i) = h(i,i + 1);
+        }
+        if (i > 0) h(i,i) += sin(b[i - 1]) * exp(b[i] / 10) / 100;
+    }
+    return h;
+}
+
+void coupled_combined(const box<N>& b, unsigned flags, evaluation<N>& e) {
+    std::array<interval, N> s, c, x;
+    for (size_t i = 0; i < N; ++i) {
+        s[i] = sin(b[i]);
+        x[i] = exp(b[i] / 10);
+        if (flags & (EVALUATE_GRADIENT | EVALUATE_HESSIAN)) c[i] = cos(b[i]);
+    }
+    if (flags & EVALUATE_VALUE) {
+        e.value = interval(0);
+        for (size_t i = 0; i < N; ++i) {
+            if (i + 1 < N) e.value += s[i] * x[i + 1];
+            e.value += sqr(b[i]) / 20;
+        }
+    }
+    if (flags & EVALUATE_GRADIENT) {
+        for (size_t i = 0; i < N; ++i) {
+            e.gradient[i] = b[i] / 10;
+            if (i + 1 < N) e.gradient[i] += c[i] * x[i + 1];
+            if (i > 0) e.gradient[i] += s[i - 1] * x[i] / 10;
+        }
+    }
+    if (flags & EVALUATE_HESSIAN) {
+        e.hessian.fill(interval(0));
+        for (size_t i = 0; i < N; ++i) {
+            e.hessian(i,i) = interval(0.1);
+            if (i + 1 < N) {
+                e.hessian(i,i) -= s[i] * x[i + 1];
+                e.hessian(i,i + 1) = c[i] * x[i + 1] / 10;
+                e.hessian(i + 1,i) = e.hessian(i,i + 1);
+            }
+            if (i > 0) e.hessian(i,i) += s[i - 1] * x[i] / 100;
+        }
+    }
+}
+
+// Best time per box of several solves, in total and in the callbacks
+void run(const std::string& name, optimizer<N>& opt, const box<N>& b0) {
+    double best = INFINITY, best_callbacks = INFINITY;
+    for (int k = 0; k < 5; ++k) {
+        opt.solve(b0);
+        const solve_statistics& s = opt.statistics();
+        best = std::min(best, opt.time() / opt.box_count());
+        best_callbacks = std::min(best_callbacks,
+            (s.func_time + s.func_d_time + s.func_dd_time) / opt.box_count());
+    }
+    std::cout << "  " << name << opt.box_count() << " boxes, "
+              << best * 1e9 << " ns/box, in callbacks "
+              << best_callbacks * 1e9 << " ns/box\n";
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    options_t o;
+    o.epsilon = 1e-6;
+    o.collect_statistics = true;
+    box<N> b0;
+    for (size_t i = 0; i < N; ++i) b0[i] = interval(-10, 10);
+
+    optimizer<N> separate(coupled, coupled_d, coupled_dd, o);
+    optimizer<N> combined(coupled, o);
+    combined.set_combined_function(coupled_combined);
+
+    std::cout << "coupled " << N << "d, value, gradient and Hessian\n";
+    run("separate ", separate, b0);
+    run("combined ", combined, b0);
+}
@@ -0,0 +1,97 @@
+#include "optimizer/optimizer.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace rapidlab;
+
+// Chained Rosenbrock function with its derivatives, written once for boxes
+// of fixed and of run-time dimension
+template <size_t N>
+interval rosenbrock_value(const box<N>& b) {
+    interval r(0);
+    for (size_t i = 0; i + 1 < b.size(); ++i) {
+        r += 100 * sqr(b[i + 1] - sqr(b[i])) + sqr(b[i] - 1);
+    }
+    return r;
+}
+
+template <size_t N>
+void rosenbrock(const box<N>& b, unsigned flags, evaluation<N>& e) {
+    const size_t n = b.size();
+    if (flags & EVALUATE_VALUE) {
+        e.value = rosenbrock_value(b);
+    }
+    if (flags & EVALUATE_GRADIENT) {
+        for (size_t i = 0; i < n; ++i) e.gradient[i] = interval(0);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            interval t = 200 * (b[i + 1] - sqr(b[i]));
+            e.gradient[i] += (1 - t) * 2 * b[i] - 2;
+            e.gradient[i + 1] += t;
+        }
+    }
+    if (flags & EVALUATE_HESSIAN) {
+        e.hessian.setConstant(interval(0));
+        for (size_t i = 0; i + 1 < n; ++i) {
+            e.hessian(i,i) += -400 * b[i] * -2 * b[i]
+                            + -400 * (b[i + 1] - sqr(b[i])) + 2;
+            e.hessian(i + 1,i + 1) += 200;
+            e.hessian(i,i + 1) += -400 * b[i];
+            e.hessian(i + 1,i) += -400 * b[i];
+        }
+    }
+}
+
+// Best time per box of several solves
+template <size_t N>
+double time_per_box(size_t n, unsigned provides, double epsilon,
+                    int64_t& boxes) {
+    options_t o;
+    o.epsilon = epsilon;
+    optimizer<N> opt(rosenbrock_value<N>, o);
+    if (provides) {
+        opt.set_combined_function(rosenbrock<N>, provides);
+    }
+    box<N> b0;
+    detail::resize(b0, n);
+    for (size_t i = 0; i < n; ++i) b0[i] = interval(-5, 5);
+
+    double best = INFINITY;
+    for (int k = 0; k < 10; ++k) {
+        opt.solve(b0);
+        best = std::min(best, opt.time() / opt.box_count());
+    }
+    boxes = opt.box_count();
+    return best;
+}
+
+template <size_t N>
+void run(double value_epsilon) {
+    const unsigned orders[] = {EVALUATE_VALUE, EVALUATE_ALL};
+    for (unsigned provides : orders) {
+        const bool all = provides == EVALUATE_ALL;
+        //without derivatives only a coarse tolerance ends in time
+        const double epsilon = all ? 1e-6 : value_epsilon;
+        int64_t fixed_boxes, dynamic_boxes;
+        double fixed_time = time_per_box<N>(N, all ? provides : 0,
+                                            epsilon, fixed_boxes);
+        double dynamic_time = time_per_box<dynamic>(N, all ? provides : 0,
+                                                    epsilon, dynamic_boxes);
+
+        std::cout << "rosenbrock" << N << "d, "
+                  << (all ? "derivatives" : "value only") << "\n"
+                  << "  box<" << N << ">       " << fixed_boxes << " boxes, "
+                  << fixed_time * 1e9 << " ns/box\n"
+                  << "  box<dynamic> " << dynamic_boxes << " boxes, "
+                  << dynamic_time * 1e9 << " ns/box\n"
+                  << "  ratio " << dynamic_time / fixed_time << "\n";
+    }
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    run<2>(1e-4);
+    run<4>(1e-2);
+    run<8>(1e-2);
+}
@@ -0,0 +1,103 @@
+#include "interval/core.hpp"
+#include "interval/interval_array.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace rapidlab;
+
+// Streams elementwise operations over large arrays, once as array of
+// intervals and once as interval_array, and reports memory throughput.
+// Results are written in place so neither layout pays for allocation.
+const size_t n = 1 << 22;
+const int repetitions = 20;
+
+template<class F>
+double seconds(F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) f();
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count() / repetitions;
+}
+
+// Streams counts every array read or written once per element
+void report(const std::string& name, double aos, double soa, size_t streams) {
+    double bytes = double(streams) * n * sizeof(interval);
+    std::cout << name << "\n"
+              << "  std::vector<interval> " << bytes / aos * 1e-9 << " GB/s\n"
+              << "  interval_array        " << bytes / soa * 1e-9 << " GB/s\n"
+              << "  speedup " << aos / soa << "\n";
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    std::vector<interval> x(n), b(n), y(n);
+    interval_array x_soa(n), b_soa(n), y_soa(n);
+    for (size_t i = 0; i < n; ++i) {
+        double t = double(i) / n;
+        x[i] = interval(t - 1, t + 0.5);
+        b[i] = interval(t + 1, 2 * t + 2);
+        y[i] = interval(t, 2 * t);
+        x_soa.set(i, x[i]);
+        b_soa.set(i, b[i]);
+        y_soa.set(i, y[i]);
+    }
+    const interval a(-0.5, 2);
+
+    double aos = seconds([&] {
+        for (size_t i = 0; i < n; ++i) y[i] = y[i] * a;
+        for (size_t i = 0; i < n; ++i) y[i] = y[i] + b[i];
+    });
+    double soa = seconds([&] {
+        y_soa *= a;
+        y_soa += b_soa;
+    });
+    report("scale and shift", aos, soa, 5);
+
+    aos = seconds([&] {
+        for (size_t i = 0; i < n; ++i) y[i] = y[i] * x[i];
+        for (size_t i = 0; i < n; ++i) y[i] = y[i] / b[i];
+    });
+    soa = seconds([&] {
+        y_soa *= x_soa;
+        y_soa /= b_soa;
+    });
+    report("multiply and divide", aos, soa, 6);
+    // Arithmetic and hull of both layouts must agree bit by bit
+    const bool same = y[n/2] == y_soa[n/2];
+
+    aos = seconds([&] {
+        for (size_t i = 0; i < n; ++i) y[i] = exp(x[i]);
+    });
+    soa = seconds([&] { y_soa = exp(x_soa); });
+    report("exp", aos, soa, 2);
+
+    aos = seconds([&] {
+        for (size_t i = 0; i < n; ++i) y[i] = log(b[i]);
+    });
+    soa = seconds([&] { y_soa = log(b_soa); });
+    report("log", aos, soa, 2);
+
+    aos = seconds([&] {
+        for (size_t i = 0; i < n; ++i) y[i] = cos(x[i]);
+    });
+    soa = seconds([&] { y_soa = cos(x_soa); });
+    report("cos", aos, soa, 2);
+
+    interval h_aos, h_soa;
+    aos = seconds([&] {
+        interval h = x[0];
+        for (size_t i = 1; i < n; ++i) {
+            h = interval(std::min(h.lower(), x[i].lower()),
+                         std::max(h.upper(), x[i].upper()));
+        }
+        h_aos = h;
+    });
+    soa = seconds([&] { h_soa = hull(x_soa); });
+    report("hull", aos, soa, 1);
+
+    std::cout << "check " << same << " " << (h_aos == h_soa) << "\n";
+}
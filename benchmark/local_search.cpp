@@ -0,0 +1,134 @@
+#include "optimizer/optimizer.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace rapidlab;
+
+// Boxes processed with and without local searches from the midpoints, on
+// Rosenbrock's valley and on the many local minima of Levy and Griewank.
+// A lower incumbent found early cuts off more boxes before they are split.
+const size_t N = 4;
+
+interval rosenbrock(const box<N>& b) {
+    interval r(0);
+    for (size_t i = 0; i + 1 < N; ++i) {
+        r += 100 * sqr(b[i + 1] - sqr(b[i])) + sqr(1 - b[i]);
+    }
+    return r;
+}
+
+std::array<interval, N> rosenbrock_d(const box<N>& b) {
+    std::array<interval, N> g;
+    for (size_t i = 0; i < N; ++i) {
+        g[i] = interval(0);
+        if (i + 1 < N) {
+            g[i] += -400 * b[i] * (b[i + 1] - sqr(b[i])) - 2 * (1 - b[i]);
+        }
+        if (i > 0) {
+            g[i] += 200 * (b[i] - sqr(b[i - 1]));
+        }
+    }
+    return g;
+}
+
+interval levy(const box<N>& b) {
+    const interval pi(pi_d_l, pi_d_u);
+    std::array<interval, N> w;
+    for (size_t i = 0; i < N; ++i) w[i] = 1 + (b[i] - 1) / 4;
+    interval r = sqr(sin(pi * w[0]));
+    for (size_t i = 0; i + 1 < N; ++i) {
+        r += sqr(w[i] - 1) * (1 + 10 * sqr(sin(pi * w[i] + 1)));
+    }
+    r += sqr(w[N - 1] - 1) * (1 + sqr(sin(2 * pi * w[N - 1])));
+    return r;
+}
+
+std::array<interval, N> levy_d(const box<N>& b) {
+    const interval pi(pi_d_l, pi_d_u);
+    std::array<interval, N> g;
+    for (size_t i = 0; i < N; ++i) {
+        const interval w = 1 + (b[i] - 1) / 4;
+        g[i] = interval(0);
+        if (i == 0) {
+            g[i] += pi * sin(2 * pi * w);
+        }
+        if (i + 1 < N) {
+            g[i] += 2 * (w - 1) * (1 + 10 * sqr(sin(pi * w + 1))) +
+                10 * pi * sqr(w - 1) * sin(2 * (pi * w + 1));
+        } else {
+            g[i] += 2 * (w - 1) * (1 + sqr(sin(2 * pi * w))) +
+                2 * pi * sqr(w - 1) * sin(4 * pi * w);
+        }
+        g[i] /= 4;
+    }
+    return g;
+}
+
+// Scales x_i by 1/sqrt(i+1) rounded to double, in the value and gradient
+// alike
+interval griewank(const box<N>& b) {
+    interval sum(0), product(1);
+    for (size_t i = 0; i < N; ++i) {
+        sum += sqr(b[i]);
+        product *= cos(b[i] * (1 / std::sqrt(i + 1.0)));
+    }
+    return 1 + sum / 4000 - product;
+}
+
+std::array<interval, N> griewank_d(const box<N>& b) {
+    std::array<interval, N> g;
+    for (size_t i = 0; i < N; ++i) {
+        const double s = 1 / std::sqrt(i + 1.0);
+        interval others(1);
+        for (size_t j = 0; j < N; ++j) {
+            if (j != i) {
+                others *= cos(b[j] * (1 / std::sqrt(j + 1.0)));
+            }
+        }
+        g[i] = b[i] / 2000 + s * sin(b[i] * s) * others;
+    }
+    return g;
+}
+
+template <class F, class D>
+void run(const std::string& name, F f, D f_d, double lower, double upper,
+         double epsilon, search_mode mode) {
+    for (int64_t every : {0, 64, 8}) {
+        options_t o;
+        o.epsilon = epsilon;
+        o.search = mode;
+        o.local_search_boxes = every;
+        optimizer<N, F, D> opt(f, f_d, o);
+
+        box<N> b0;
+        for (size_t i = 0; i < N; ++i) b0[i] = interval(lower, upper);
+        opt.solve(b0);
+
+        const solve_statistics& s = opt.statistics();
+        std::cout << name << " every " << every << "\t"
+                  << opt.box_count() << " boxes, " << opt.time() << " s, "
+                  << s.local_searches << " local searches, "
+                  << s.local_improvements << " improving, minimum "
+                  << opt.minimum() << "\n";
+    }
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+    typedef interval (*func)(const box<N>&);
+    typedef std::array<interval, N> (*func_d)(const box<N>&);
+    const search_mode modes[] = {search_mode::DEPTH_FIRST,
+                                 search_mode::BEST_FIRST};
+    const char* names[] = {"depth-first", "best-first "};
+    for (size_t k = 0; k < 2; ++k) {
+        std::cout << names[k] << "\n";
+        run<func, func_d>("rosenbrock", rosenbrock, rosenbrock_d, -5, 5, 1e-6,
+                          modes[k]);
+        run<func, func_d>("levy      ", levy, levy_d, -10, 10, 1e-4,
+                          modes[k]);
+        run<func, func_d>("griewank  ", griewank, griewank_d, -30, 70, 1e-4,
+                          modes[k]);
+    }
+}
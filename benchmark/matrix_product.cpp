@@ -0,0 +1,69 @@
+#include "interval/core.hpp"
+#include "interval/eigen_support.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace rapidlab;
+
+// Multiplies 50x50 matrices as in the preconditioning of Gauss-Seidel, with
+// Eigen's generic product over interval scalars against the midpoint-radius
+// product through double GEMM
+const int n = 50;
+const int repetitions = 2000;
+
+typedef Eigen::Matrix<interval, n, n> imatrix;
+typedef Eigen::Matrix<double, n, n> dmatrix;
+
+// Microseconds per product
+template<class F>
+double run(F f) {
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < repetitions; ++k) f();
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count() / repetitions * 1e6;
+}
+
+double mean_diam(const imatrix& c) {
+    double s = 0;
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) s += diam(c(i, j));
+    }
+    return s / (n * n);
+}
+
+int main() {
+    rounding_guard<rounding::upward> guard;
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> lower(-1, 1), width(0, 0.01);
+    imatrix a, b;
+    dmatrix p;
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            double l = lower(generator);
+            a(i, j) = interval(l, l + width(generator));
+            l = lower(generator);
+            b(i, j) = interval(l, l + width(generator));
+            p(i, j) = lower(generator);
+        }
+    }
+    const imatrix pi = p.cast<interval>();
+
+    imatrix generic, midrad;
+    double t_generic = run([&] { generic.noalias() = a * b; });
+    double t_midrad = run([&] { midrad = mid_rad_product(a, b); });
+    std::cout << "interval * interval   generic " << t_generic
+              << " us   mid-rad " << t_midrad << " us   speedup "
+              << t_generic / t_midrad << "\n";
+    std::cout << "  mean width          generic " << mean_diam(generic)
+              << "   mid-rad " << mean_diam(midrad) << "\n";
+
+    t_generic = run([&] { generic.noalias() = pi * a; });
+    t_midrad = run([&] { midrad = mid_rad_product(p, a); });
+    std::cout << "point * interval      generic " << t_generic
+              << " us   mid-rad " << t_midrad << " us   speedup "
+              << t_generic / t_midrad << "\n";
+    std::cout << "  mean width          generic " << mean_diam(generic)
+              << "   mid-rad " << mean_diam(midrad) << "\n";
+}
@@ -0,0 +1,112 @@
+#include "optimizer/optimizer.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace rapidlab;
+
+// Levy function in 8 dimensions. Its many local minima leave lower bounds
+// below the incumbent over much of the box, so best-first and breadth-first
+// search keep many open boxes.
+const size_t N = 8;
+
+interval levy(const box<N>& b) {
+    const interval pi(pi_d_l, pi_d_u);
+    std::array<interval, N> w;
+    for (size_t i = 0; i < N; ++i) w[i] = 1 + (b[i] - 1) / 4;
+    interval r = sqr(sin(pi * w[0]));
+    for (size_t i = 0; i + 1 < N; ++i) {
+        r += sqr(w[i] - 1) * (1 + 10 * sqr(sin(pi * w[i] + 1)));
+    }
+    r += sqr(w[N - 1] - 1) * (1 + sqr(sin(2 * pi * w[N - 1])));
+    return r;
+}
+
+// Styblinski-Tang function in 8 dimensions. Its lower bounds stay below
+// the incumbent over boxes of 2^8 similar local minima, so best-first
+// search leaves about one open box per box processed.
+interval styblinski_tang(const box<N>& b) {
+    interval r(0);
+    for (size_t i = 0; i < N; ++i) {
+        r += sqr(sqr(b[i])) - 16 * sqr(b[i]) + 5 * b[i];
+    }
+    return r / 2;
+}
+
+// Function, search box and tolerance, and boxes after which the search
+// stops, 0 runs it to the end
+struct problem {
+    optimizer<N>::func_t f;
+    double lower;
+    double upper;
+    double epsilon;
+    int64_t max_boxes;
+};
+
+// Peak resident set of this process in kB
+long peak_rss() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return -1;
+}
+
+// Solves in a child process, so every run starts from the same peak
+void run(const std::string& name, const problem& p, search_mode mode,
+         bool compact, size_t max_memory_boxes = 0) {
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid != 0) {
+        waitpid(pid, nullptr, 0);
+        return;
+    }
+
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+    options_t o;
+    o.epsilon = p.epsilon;
+    o.max_boxes = p.max_boxes;
+    o.search = mode;
+    o.compact_boxes = compact;
+    o.max_memory_boxes = max_memory_boxes;
+    optimizer<N> opt(p.f, o);
+
+    box<N> b0;
+    for (size_t i = 0; i < N; ++i) b0[i] = interval(p.lower, p.upper);
+    const long before = peak_rss();
+    opt.solve(b0);
+
+    std::cout << name << (compact ? " compact " :
+                          max_memory_boxes ? " spilled " : " full    ")
+              << opt.box_count() << " boxes, "
+              << opt.time() / opt.box_count() * 1e9 << " ns/box, peak RSS +"
+              << (peak_rss() - before) / 1024.0 << " MB\n";
+    std::cout.flush();
+    _exit(0);
+}
+
+int main() {
+    std::cout << "sizeof(box<" << N << ">) " << sizeof(box<N>) << " bytes\n";
+    const problem levy8 = {levy, -10, 10, 1e-1, 0};
+    std::cout << "levy\n";
+    run("best-first   ", levy8, search_mode::BEST_FIRST, false);
+    run("best-first   ", levy8, search_mode::BEST_FIRST, true);
+    run("breadth-first", levy8, search_mode::BREADTH_FIRST, false);
+    run("breadth-first", levy8, search_mode::BREADTH_FIRST, true);
+    run("best-first   ", levy8, search_mode::BEST_FIRST, false, 1 << 12);
+    run("breadth-first", levy8, search_mode::BREADTH_FIRST, false, 1 << 12);
+
+    const problem styblinski8 = {styblinski_tang, -5, 5, 1e-2, 1 << 20};
+    std::cout << "styblinski-tang, stopped after " << styblinski8.max_boxes
+              << " boxes\n";
+    run("best-first   ", styblinski8, search_mode::BEST_FIRST, false);
+    run("best-first   ", styblinski8, search_mode::BEST_FIRST, true);
+    run("best-first   ", styblinski8, search_mode::BEST_FIRST, false, 1 << 12);
+}
@@ -0,0 +1,58 @@
+#include "optimizer/optimizer.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+using namespace rapidlab;
+
+// Styblinski-Tang function, 2^dim local minima
+const size_t dim = 6;
+
+interval styblinski_tang(const box<dim>& b) {
+    interval r(0);
+    for (size_t i = 0; i < dim; ++i) {
+        interval x2 = sqr(b[i]);
+        r += sqr(x2) - 16 * x2 + 5 * b[i];
+    }
+    return 0.5 * r;
+}
+
+std::array<interval, dim> styblinski_tang_d(const box<dim>& b) {
+    std::array<interval, dim> g;
+    for (size_t i = 0; i < dim; ++i) {
+        g[i] = 2 * sqr(b[i]) * b[i] - 16 * b[i] + 2.5;
+    }
+    return g;
+}
+
+int main(int argc, char** argv) {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (argc > 1) {
+        max_threads = std::atoi(argv[1]);
+    }
+
+    box<dim> b0;
+    for (size_t i = 0; i < dim; ++i) {
+        b0[i] = interval(-5, 5);
+    }
+
+    std::cout << "threads\tboxes\ttime[s]\tboxes/s\tspeedup\n";
+    double base_rate = 0;
+    for (unsigned n = 1; n <= std::max(1u, max_threads); ++n) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.threads = n;
+        optimizer<dim> opt(styblinski_tang, o);
+        opt.set_first_derivative(styblinski_tang_d);
+        opt.solve(b0);
+
+        double rate = opt.box_count() / opt.time();
+        if (n == 1) {
+            base_rate = rate;
+        }
+        std::cout << n << "\t" << opt.box_count() << "\t" << opt.time()
+                  << "\t" << rate << "\t" << rate / base_rate << "\n";
+    }
+}
@@ -0,0 +1,80 @@
+#include "interval/core.hpp"
+#include "interval/rounding.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace rapidlab;
+
+// Runs each interval operator under the three ways of rounding: upward
+// rounding set once, error-free transformations under round to nearest,
+// and upward rounding set and restored by a guard around every operation
+const size_t n = 1 << 12;
+const int repetitions = 2000;
+
+enum operation { ADD, MUL, DIV, SQR, SQRT };
+
+template<class policy>
+interval apply(operation op, const interval& a, const interval& b) {
+    switch (op) {
+    case ADD: return detail::add<policy>(a, b);
+    case MUL: return detail::mul<policy>(a, b);
+    case DIV: return detail::div<policy>(a, b);
+    case SQR: return detail::sqr<policy>(a);
+    default: return detail::sqrt<policy>(b);
+    }
+}
+
+// Nanoseconds per operation
+template<class policy, bool guarded>
+double run(operation op, const std::vector<interval>& x,
+           const std::vector<interval>& y, std::vector<interval>& r) {
+    auto start = std::chrono::steady_clock::now();
+    for (int k = 0; k < repetitions; ++k) {
+        for (size_t i = 0; i < n; ++i) {
+            if (guarded) {
+                rounding_guard<policy> guard;
+                r[i] = apply<policy>(op, x[i], y[i]);
+            } else {
+                r[i] = apply<policy>(op, x[i], y[i]);
+            }
+        }
+    }
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+    return d.count() / repetitions / n * 1e9;
+}
+
+int main() {
+    std::vector<interval> x(n), y(n), r_up(n), r_nearest(n), r_guarded(n);
+    for (size_t i = 0; i < n; ++i) {
+        double t = double(i) / n;
+        x[i] = interval(t - 0.7, t + 0.3);
+        y[i] = interval(t + 0.5, 2 * t + 1);
+    }
+
+    const operation ops[] = {ADD, MUL, DIV, SQR, SQRT};
+    const char* names[] = {"add ", "mul ", "div ", "sqr ", "sqrt"};
+    std::cout << "ns per operation   upward   nearest   guarded\n";
+    size_t identical = 0;
+    for (operation op : ops) {
+        double up, nearest, guarded;
+        {
+            rounding_guard<rounding::upward> scope;
+            up = run<rounding::upward, false>(op, x, y, r_up);
+        }
+        {
+            rounding_guard<rounding::nearest> scope;
+            nearest = run<rounding::nearest, false>(op, x, y, r_nearest);
+            guarded = run<rounding::upward, true>(op, x, y, r_guarded);
+        }
+        std::cout << "  " << names[op] << "             " << up << "   "
+                  << nearest << "   " << guarded << "\n";
+        // All three must give the same bounds
+        for (size_t i = 0; i < n; ++i) {
+            identical += (r_up[i] == r_nearest[i]) && (r_up[i] == r_guarded[i]);
+        }
+    }
+    std::cout << "identical results " << identical << " of " << 5 * n << "\n";
+}
@@ -0,0 +1,47 @@
+#include "optimizer/optimizer.hpp"
+
+#include <iostream>
+
+using namespace rapidlab;
+
+// Boxes processed after seeding the incumbent from quasi-random points, on
+// the Levy function in 5 dimensions, whose local minima keep lower bounds
+// below a poor incumbent over much of the box.
+const size_t N = 5;
+
+interval levy(const box<N>& b) {
+    const interval pi(pi_d_l, pi_d_u);
+    std::array<interval, N> w;
+    for (size_t i = 0; i < N; ++i) w[i] = 1 + (b[i] - 1) / 4;
+    interval r = sqr(sin(pi * w[0]));
+    for (size_t i = 0; i + 1 < N; ++i) {
+        r += sqr(w[i] - 1) * (1 + 10 * sqr(sin(pi * w[i] + 1)));
+    }
+    r += sqr(w[N - 1] - 1) * (1 + sqr(sin(2 * pi * w[N - 1])));
+    return r;
+}
+
+int main() {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+    for (int64_t points : {0, 1000, 10000, 100000}) {
+        options_t o;
+        o.epsilon = 1e-1;
+        o.search = search_mode::DEPTH_FIRST;
+        o.seed_points = points;
+        o.collect_statistics = true;
+        optimizer<N> opt(levy, o);
+
+        box<N> b0;
+        for (size_t i = 0; i < N; ++i) b0[i] = interval(-7, 13);
+        opt.solve(b0);
+
+        //lowest incumbent before the first box
+        double seeded = INFINITY;
+        for (const solve_statistics::incumbent& i : opt.statistics().incumbents) {
+            if (i.boxes == 0) seeded = i.value;
+        }
+        std::cout << points << " seed points\t" << opt.box_count()
+                  << " boxes, " << opt.time() << " s, seeded incumbent "
+                  << seeded << ", minimum " << opt.minimum() << "\n";
+    }
+}
@@ -3,6 +3,7 @@
 
 #include "interval.hpp"
 #include "constants.hpp"
+#include "rounding.hpp"
 
 #include <cmath>
 
@@ -16,11 +17,28 @@ inline __m128d c_swap(__m128d a, __m128d cond) {
     return _mm_xor_pd(cond, a);
 }
 
+// Integer above r, what rint gives rounding up. Spelled out since the
+// compiler may inline rint assuming round to nearest.
 inline double to_int(double r) {
-    return rint(r);
+    return std::ceil(r);
 }
 
+// Library functions are accurate to less than one ulp with round to
+// nearest. Scope evaluates them that way and restores the rounding mode.
+using nearest_rounding_scope = rounding_guard<rounding::nearest>;
+
+inline double next_down(double d) {
+    return std::nextafter(d, -INFINITY);
+}
+
+inline double next_up(double d) {
+    return std::nextafter(d, INFINITY);
+}
+
+// Operator kernels, templated on the rounding policy
+template<class P>
 inline interval recip(const interval& a) {
+    check_rounding<P>();
     __m128d x = a.value();
 
 	// Interval spans over zero
@@ -30,7 +48,109 @@ inline interval recip(const interval& a) {
 
     x = _mm_shuffle_pd(x, x, 1);
 
-	return interval(_mm_div_pd((__m128d){-1.0, -1.0}, x));
+	return interval(P::div((__m128d){-1.0, -1.0}, x));
+}
+
+template<class P>
+inline interval add(const interval& a, const interval& b) {
+    check_rounding<P>();
+    return interval(P::add(a.value(), b.value()));
+}
+
+template<class P>
+inline interval mul(const interval& a, double b) {
+    check_rounding<P>();
+    if (b < 0) {
+        return interval(P::mul(_mm_shuffle_pd(a.value(), a.value(), 1),
+                               _mm_set1_pd(-b)));
+    }
+    return interval(P::mul(a.value(), _mm_set1_pd(b)));
+}
+
+template<class P>
+inline interval mul(const interval& a, const interval& b) {
+    check_rounding<P>();
+    __m128d x = a.value();
+    __m128d y = b.value();
+    __m128d t1 = _mm_castsi128_pd(_mm_shuffle_epi32(_mm_castpd_si128(x), 0xee));
+	__m128d t2 = _mm_castsi128_pd(_mm_shuffle_epi32(_mm_castpd_si128(y), 0xee));
+
+	__m128d t3 = _mm_xor_pd(x, t1);
+	__m128d t4 = _mm_xor_pd(y, t2);
+
+	if (_mm_movemask_pd(_mm_and_pd(t3, t4))) {
+		__m128d c = _mm_set1_pd(0.0);
+		__m128d c1 = _mm_cmple_pd(t2, c);
+		__m128d c2 = _mm_cmple_pd(t1, c);
+		__m128d c3 = _mm_set_pd(0.0, -0.0);
+
+		x = c_swap(_mm_xor_pd(x, c3), c1);
+		y = c_swap(_mm_xor_pd(y, c3), c2);
+
+		return interval(P::mul(x, _mm_xor_pd(y, c3)));
+	}
+    // Zero overlap
+    t1 = P::mul(_mm_castsi128_pd(
+            _mm_shuffle_epi32(_mm_castpd_si128(x), 0x4e)),
+            _mm_unpacklo_pd(y, y));
+    t2 = P::mul(t2, x);
+
+    return interval(_mm_max_pd(t1, t2));
+}
+
+template<class P>
+inline interval div(const interval& a, double b) {
+    check_rounding<P>();
+    if (b == 0) {
+        return interval(_mm_set1_pd(INFINITY));
+    } else if (b < 0) {
+        return interval(P::div(_mm_shuffle_pd(a.value(), a.value(), 1),
+                               _mm_set1_pd(-b)));
+    }
+    return interval(P::div(a.value(), _mm_set1_pd(b)));
+}
+
+template<class P>
+inline interval div(const interval& a, const interval& b) {
+    return mul<P>(a, recip<P>(b));
+}
+
+template<class P>
+inline interval sqrt(const interval& a) {
+    check_rounding<P>();
+	if (a.value()[0] > 0) return interval(_mm_set1_pd(NAN));
+
+    // Two roundings to counteract with multiply
+    __m128d x = P::mul(a.value(), (__m128d) {-0x1.ffffffffffff8p-1, 1.0});
+	x = P::sqrt(x);
+
+	return interval(_mm_xor_pd(x, _mm_set_pd(0.0, -0.0)));
+}
+
+template<class P>
+inline interval sqr(const interval& a) {
+    check_rounding<P>();
+    __m128d x = a.value();
+
+    // Take high bit value
+    __m128d t1 = _mm_castsi128_pd(_mm_shuffle_epi32(_mm_castpd_si128(x), 0xee));
+
+    if (_mm_movemask_pd(_mm_xor_pd(x, t1))) {
+        // Interval not containing zero
+        __m128d c = _mm_set1_pd(0.0);
+        // Compare: is sup(x) <= 0?
+        __m128d c1 = _mm_cmple_pd(t1, c);
+        __m128d c3 = _mm_set_pd(0.0, -0.0);
+        // Swap for sup(x) <= 0
+        x = c_swap(_mm_xor_pd(x, c3), c1);
+
+        return interval(P::mul(x, _mm_xor_pd(x, c3)));
+    }
+    // Interval contains zero
+    __m128d t2 = _mm_unpacklo_pd(x, x);
+	__m128d t5 = _mm_max_pd(P::mul(t1, t1), P::mul(t2, t2));
+	__m128d result = _mm_set_pd(t5[0], -0.0);
+    return interval(result);
 }
 
 } // namespace detail
@@ -62,7 +182,7 @@ inline interval operator-(const interval& a) {
 // OPERATOR PLUS //
 ///////////////////
 inline interval& operator+=(interval& a, const interval& b) {
-    a.value() = _mm_add_pd(a.value(), b.value());
+    a = detail::add<rounding_policy>(a, b);
     return a;
 }
 
@@ -88,11 +208,7 @@ inline interval operator-(const interval& a, const interval& b) {
 // OPERATOR MULTIPLICATION //
 /////////////////////////////
 inline interval& operator*=(interval& a, double b) {
-    if (b < 0) {
-        a.value() = _mm_mul_pd((-a).value(), _mm_set1_pd(-b));
-    } else {
-        a.value() = _mm_mul_pd(a.value(), _mm_set1_pd(b));
-    }
+    a = detail::mul<rounding_policy>(a, b);
     return a;
 }
 
@@ -107,33 +223,7 @@ inline interval operator*(double a, const interval& b) {
 }
 
 inline interval& operator*=(interval& a, const interval& b) {
-    __m128d x = a.value();
-    __m128d y = b.value();
-    __m128d t1 = _mm_castsi128_pd(_mm_shuffle_epi32(_mm_castpd_si128(x), 0xee));
-	__m128d t2 = _mm_castsi128_pd(_mm_shuffle_epi32(_mm_castpd_si128(y), 0xee));
-
-	__m128d t3 = _mm_xor_pd(x, t1);
-	__m128d t4 = _mm_xor_pd(y, t2);
-
-	if (_mm_movemask_pd(_mm_and_pd(t3, t4))) {
-		__m128d c = _mm_set1_pd(0.0);
-		__m128d c1 = _mm_cmple_pd(t2, c);
-		__m128d c2 = _mm_cmple_pd(t1, c);
-		__m128d c3 = _mm_set_pd(0.0, -0.0);
-
-		x = detail::c_swap(_mm_xor_pd(x, c3), c1);
-		y = detail::c_swap(_mm_xor_pd(y, c3), c2);
-
-		a.value() = x * _mm_xor_pd(y, c3);
-	} else {
-    	// Zero overlap
-    	t1 = _mm_mul_pd(_mm_castsi128_pd(
-                _mm_shuffle_epi32(_mm_castpd_si128(x), 0x4e)),
-                _mm_unpacklo_pd(y, y));
-    	t2 = _mm_mul_pd(t2, x);
-
-        a.value() = _mm_max_pd(t1, t2);
-    }
+    a = detail::mul<rounding_policy>(a, b);
     return a;
 }
 
@@ -147,13 +237,7 @@ inline interval operator*(const interval& a, const interval& b) {
 // OPERATOR DIVISION //
 ///////////////////////
 inline interval& operator/=(interval& a, double b) {
-    if (b == 0) {
-        a.value() = _mm_set1_pd(INFINITY);
-    } else if (b < 0) {
-        a.value() = _mm_div_pd((-a).value(), _mm_set1_pd(-b));
-    } else {
-        a.value() = _mm_div_pd(a.value(), _mm_set1_pd(b));
-    }
+    a = detail::div<rounding_policy>(a, b);
     return a;
 }
 
@@ -164,11 +248,11 @@ inline interval operator/(const interval& a, double b) {
 }
 
 inline interval operator/(double a, const interval& b) {
-    return a * detail::recip(b);
+    return a * detail::recip<rounding_policy>(b);
 }
 
 inline interval& operator/=(interval& a, const interval& b) {
-	a = a * detail::recip(b);
+	a = detail::div<rounding_policy>(a, b);
     return a;
 }
 
@@ -182,38 +266,11 @@ inline interval operator/(const interval& a, const interval& b) {
 // SQRT AND SQR //
 //////////////////
 inline interval sqrt(const interval& a) {
-	if (a.value()[0] > 0) return interval(_mm_set1_pd(NAN));
-
-    __m128d x = a.value();
-    // Two roundings to counteract with multiply
-    x *= (__m128d) {-0x1.ffffffffffff8p-1, 1.0};
-	x = _mm_sqrt_pd(x);
-
-	return interval(_mm_xor_pd(x, _mm_set_pd(0.0, -0.0)));
+    return detail::sqrt<rounding_policy>(a);
 }
 
 inline interval sqr(const interval& a) {
-    __m128d x = a.value();
-
-    // Take high bit value
-    __m128d t1 = _mm_castsi128_pd(_mm_shuffle_epi32(_mm_castpd_si128(x), 0xee));
-
-    if (_mm_movemask_pd(_mm_xor_pd(x, t1))) {
-        // Interval not containing zero
-        __m128d c = _mm_set1_pd(0.0);
-        // Compare: is sup(x) <= 0?
-        __m128d c1 = _mm_cmple_pd(t1, c);
-        __m128d c3 = _mm_set_pd(0.0, -0.0);
-        // Swap for sup(x) <= 0
-        x = detail::c_swap(_mm_xor_pd(x, c3), c1);
-
-        return interval(_mm_mul_pd(x, _mm_xor_pd(x, c3)));
-    }
-    // Interval contains zero
-    __m128d t2 = _mm_unpacklo_pd(x, x);
-	__m128d t5 = _mm_max_pd(_mm_mul_pd(t1, t1), _mm_mul_pd(t2, t2));
-	__m128d result = _mm_set_pd(t5[0], -0.0);
-    return interval(result);
+    return detail::sqr<rounding_policy>(a);
 }
 
 inline interval abs(const interval& a) {
@@ -262,6 +319,27 @@ inline interval sin(const interval& a) {
     return r;
 }
 
+//////////////////////////////
+// EXPONENTIAL AND LOGARITHM //
+//////////////////////////////
+inline interval exp(const interval& a) {
+    detail::nearest_rounding_scope scope;
+    // Widen library results by one ulp in outward direction
+    double l = std::max(0.0, detail::next_down(std::exp(a.lower())));
+    double u = detail::next_up(std::exp(a.upper()));
+    return interval(l, u);
+}
+
+inline interval log(const interval& a) {
+    if (a.upper() < 0) return interval(_mm_set1_pd(NAN));
+
+    detail::nearest_rounding_scope scope;
+    double l = (a.lower() > 0) ?
+        detail::next_down(std::log(a.lower())) : -INFINITY;
+    double u = detail::next_up(std::log(a.upper()));
+    return interval(l, u);
+}
+
 /////////////////////////////
 // EIGEN TYPE REQUIREMENTS //
 /////////////////////////////
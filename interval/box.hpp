@@ -2,14 +2,24 @@
 #define RapidLab_box_hpp
 
 #include "interval.hpp"
+#include "pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <utility>
+#include <vector>
 
 namespace rapidlab {
 
+// Size of boxes whose dimension is only known at run time
+const size_t dynamic = static_cast<size_t>(-1);
+
 template<size_t _size> class box;
 
 template<size_t _size>
 std::ostream& operator<<(std::ostream& os, const box<_size>& b) {
-    for (size_t i = 0; i < _size; ++i) {
+    for (size_t i = 0; i < b.size(); ++i) {
         os << b[i] << "\n";
     }
     return os;
@@ -20,10 +30,15 @@ class box {
 private:
     std::array<interval, _size> data;
     double rank;
+    // Number of splits from the initial box
+    unsigned depth = 0;
 
 public:
     using iterator = typename std::array<interval, _size>::iterator;
     using const_iterator = typename std::array<interval, _size>::const_iterator;
+    // Point and vector of intervals of the same dimension
+    using point_t = std::array<double, _size>;
+    using vector_t = std::array<interval, _size>;
 
     box() {}
     box(const std::array<interval, _size>& d) : data(d) {}
@@ -35,16 +50,123 @@ public:
     iterator end() { return data.end(); }
     const_iterator begin() const { return data.begin(); }
     const_iterator end() const { return data.end(); }
+    size_t size() const { return _size; }
 
     interval& operator[](size_t index) { return data[index]; }
     const interval& operator[](size_t index) const { return data[index]; }
+    const std::array<interval, _size>& coordinates() const { return data; }
 
     double get_rank() const { return rank; }
     void set_rank(double r) { rank = r; }
 
+    unsigned get_depth() const { return depth; }
+    void set_depth(unsigned d) { depth = d; }
+
     friend std::ostream& operator<<<>(std::ostream& os, const box<_size>& b);
 };
 
+// Box of a dimension set at run time. The bounds are stored contiguously in
+// an array of the interval pool, so copies in and out of the open lists
+// reuse the storage of released boxes.
+template<>
+class box<dynamic> {
+private:
+    interval* data = nullptr;
+    size_t n = 0;
+    double rank;
+    // Number of splits from the initial box
+    unsigned depth = 0;
+
+    void assign(const interval* d, size_t size) {
+        if (size != n) {
+            detail::interval_pool::release(data, n);
+            data = size ? detail::interval_pool::allocate(size) : nullptr;
+            n = size;
+        }
+        std::copy(d, d + size, data);
+    }
+
+public:
+    using iterator = interval*;
+    using const_iterator = const interval*;
+    using point_t = std::vector<double>;
+    using vector_t = std::vector<interval>;
+
+    box() {}
+    // Coordinates are left uninitialized
+    explicit box(size_t size) : n(size) {
+        data = size ? detail::interval_pool::allocate(size) : nullptr;
+    }
+    box(std::initializer_list<interval> d) { assign(d.begin(), d.size()); }
+    box(const std::vector<interval>& d) { assign(d.data(), d.size()); }
+    box(const std::vector<double>& d) : box(d.size()) {
+        std::copy(d.begin(), d.end(), data);
+    }
+    box(const box& b) : rank(b.rank), depth(b.depth) { assign(b.data, b.n); }
+    box(box&& b) noexcept : data(b.data), n(b.n), rank(b.rank), depth(b.depth) {
+        b.data = nullptr;
+        b.n = 0;
+    }
+    ~box() { detail::interval_pool::release(data, n); }
+
+    box& operator=(const box& b) {
+        if (this != &b) {
+            assign(b.data, b.n);
+            rank = b.rank;
+            depth = b.depth;
+        }
+        return *this;
+    }
+    box& operator=(box&& b) noexcept {
+        std::swap(data, b.data);
+        std::swap(n, b.n);
+        rank = b.rank;
+        depth = b.depth;
+        return *this;
+    }
+
+    iterator begin() { return data; }
+    iterator end() { return data + n; }
+    const_iterator begin() const { return data; }
+    const_iterator end() const { return data + n; }
+    size_t size() const { return n; }
+
+    interval& operator[](size_t index) { return data[index]; }
+    const interval& operator[](size_t index) const { return data[index]; }
+
+    double get_rank() const { return rank; }
+    void set_rank(double r) { rank = r; }
+
+    unsigned get_depth() const { return depth; }
+    void set_depth(unsigned d) { depth = d; }
+};
+
+namespace detail {
+
+// Sizes vectors of dynamic dimension, fixed sizes are left as they are
+template<class T, size_t _size>
+inline void resize(std::array<T, _size>&, size_t n) {
+    assert(n == _size);
+    (void)n;
+}
+
+template<class T>
+inline void resize(std::vector<T>& v, size_t n) { v.resize(n); }
+
+template<size_t _size>
+inline void resize(box<_size>&, size_t n) {
+    assert(n == _size);
+    (void)n;
+}
+
+inline void resize(box<dynamic>& b, size_t n) {
+    if (b.size() != n) {
+        b = box<dynamic>(n);
+    }
+}
+
+} // namespace detail
+
 template<size_t _size>
 inline int operator<(const box<_size>& a, const box<_size>& b) {
     //operator needed for heap transform of a list
@@ -52,18 +174,31 @@ inline int operator<(const box<_size>& a, const box<_size>& b) {
 }
 
 template<size_t _size>
-inline std::array<double, _size> mid(const box<_size>& b) {
-    std::array<double, _size> a;
-    for (size_t i = 0; i < _size; ++i) {
+inline typename box<_size>::point_t mid(const box<_size>& b) {
+    typename box<_size>::point_t a;
+    detail::resize(a, b.size());
+    for (size_t i = 0; i < b.size(); ++i) {
         a[i] = mid(b[i]);
     }
     return a;
 }
 
+// Point box m at the midpoint of b, reusing the storage of m
+template<size_t _size>
+inline void mid(const box<_size>& b, box<_size>& m) {
+    if (m.size() != b.size()) {
+        m = b;
+    }
+    for (size_t i = 0; i < b.size(); ++i) {
+        m[i] = interval(mid(b[i]));
+    }
+}
+
 template<size_t _size>
-inline std::array<double, _size> diam(const box<_size>& b) {
-    std::array<double, _size> a;
-    for (size_t i = 0; i < _size; ++i) {
+inline typename box<_size>::point_t diam(const box<_size>& b) {
+    typename box<_size>::point_t a;
+    detail::resize(a, b.size());
+    for (size_t i = 0; i < b.size(); ++i) {
         a[i] = diam(b[i]);
     }
     return a;
@@ -0,0 +1,69 @@
+#ifndef RapidLab_box_block_hpp
+#define RapidLab_box_block_hpp
+
+#include "box.hpp"
+
+#include <type_traits>
+
+namespace rapidlab {
+
+// Block of boxes stored coordinate by coordinate (structure of arrays).
+// The intervals of one coordinate of all boxes are contiguous in memory,
+// so that packed interval types can evaluate several boxes at once.
+// Blocks of dynamic boxes take the dimension of the first box pushed.
+template<size_t _size, size_t _block = 8>
+class box_block {
+private:
+    using coordinate_t = std::array<interval, _block>;
+    typename std::conditional<_size == dynamic, std::vector<coordinate_t>,
+        std::array<coordinate_t, _size>>::type data;
+    size_t count = 0;
+
+public:
+    static const size_t capacity = _block;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == _block; }
+    void clear() { count = 0; }
+
+    void push_back(const box<_size>& b) {
+        assert(count < _block && "box block is full");
+        detail::resize(data, b.size());
+        for (size_t i = 0; i < b.size(); ++i) {
+            data[i][count] = b[i];
+        }
+        ++count;
+    }
+
+    // Fill unused slots with copies of the last box, so that functions
+    // can evaluate every slot of the block without branching
+    void pad() {
+        assert(count > 0 && "cannot pad an empty box block");
+        for (size_t i = 0; i < data.size(); ++i) {
+            for (size_t k = count; k < _block; ++k) {
+                data[i][k] = data[i][count - 1];
+            }
+        }
+    }
+
+    box<_size> get(size_t k) const {
+        box<_size> b;
+        detail::resize(b, data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            b[i] = data[i][k];
+        }
+        return b;
+    }
+
+    // Coordinate index of all boxes in the block
+    interval* operator[](size_t index) { return data[index].data(); }
+    const interval* operator[](size_t index) const { return data[index].data(); }
+};
+
+template<size_t _size, size_t _block>
+const size_t box_block<_size, _block>::capacity;
+
+} // namespace rapidlab
+
+#endif
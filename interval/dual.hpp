@@ -0,0 +1,290 @@
+#ifndef RapidLab_dual_hpp
+#define RapidLab_dual_hpp
+
+#include "core.hpp"
+#include "box.hpp"
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace rapidlab {
+
+// Forward mode automatic differentiation over intervals. A dual holds an
+// enclosure of a function value and of its gradient with respect to _size
+// variables. Every gradient component is an interval, so the loops over the
+// gradient run as one register operation per component.
+template<size_t _size>
+class dual {
+private:
+    interval v;
+    std::array<interval, _size> d;
+
+public:
+    dual() : v(0) { d.fill(interval(0)); }
+    // Constant
+    dual(double a) : v(a) { d.fill(interval(0)); }
+    dual(const interval& a) : v(a) { d.fill(interval(0)); }
+    // Variable k, its gradient is the k-th unit vector
+    dual(const interval& a, size_t k) : v(a) {
+        d.fill(interval(0));
+        d[k] = interval(1);
+    }
+
+    const interval& value() const { return v; }
+    interval& value() { return v; }
+    const std::array<interval, _size>& gradient() const { return d; }
+    std::array<interval, _size>& gradient() { return d; }
+
+    const interval& operator[](size_t k) const { return d[k]; }
+    interval& operator[](size_t k) { return d[k]; }
+};
+
+// Independent variables over a box
+template<size_t _size>
+inline std::array<dual<_size>, _size> variables(const box<_size>& b) {
+    std::array<dual<_size>, _size> x;
+    for (size_t k = 0; k < _size; ++k) {
+        x[k] = dual<_size>(b[k], k);
+    }
+    return x;
+}
+
+namespace detail {
+
+// Chain rule for f(a) with derivative f' enclosed by s over a
+template<size_t _size>
+inline dual<_size> chain(const interval& v, const interval& s,
+                         const dual<_size>& a) {
+    dual<_size> c(v);
+    for (size_t k = 0; k < _size; ++k) c[k] = s * a[k];
+    return c;
+}
+
+} // namespace detail
+
+//////////////////////
+// UNARY PLUS MINUS //
+//////////////////////
+template<size_t _size>
+inline const dual<_size>& operator+(const dual<_size>& a) {
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size> operator-(const dual<_size>& a) {
+    dual<_size> c(-a.value());
+    for (size_t k = 0; k < _size; ++k) c[k] = -a[k];
+    return c;
+}
+
+///////////////////
+// OPERATOR PLUS //
+///////////////////
+template<size_t _size>
+inline dual<_size>& operator+=(dual<_size>& a, const dual<_size>& b) {
+    a.value() += b.value();
+    for (size_t k = 0; k < _size; ++k) a[k] += b[k];
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size>& operator+=(dual<_size>& a, const interval& b) {
+    a.value() += b;
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size> operator+(const dual<_size>& a, const dual<_size>& b) {
+    dual<_size> c(a);
+    c += b;
+    return c;
+}
+
+template<size_t _size>
+inline dual<_size> operator+(const dual<_size>& a, const interval& b) {
+    dual<_size> c(a);
+    c += b;
+    return c;
+}
+
+template<size_t _size>
+inline dual<_size> operator+(const interval& a, const dual<_size>& b) {
+    return b + a;
+}
+
+////////////////////
+// OPERATOR MINUS //
+////////////////////
+template<size_t _size>
+inline dual<_size>& operator-=(dual<_size>& a, const dual<_size>& b) {
+    a.value() -= b.value();
+    for (size_t k = 0; k < _size; ++k) a[k] -= b[k];
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size>& operator-=(dual<_size>& a, const interval& b) {
+    a.value() -= b;
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size> operator-(const dual<_size>& a, const dual<_size>& b) {
+    dual<_size> c(a);
+    c -= b;
+    return c;
+}
+
+template<size_t _size>
+inline dual<_size> operator-(const dual<_size>& a, const interval& b) {
+    dual<_size> c(a);
+    c -= b;
+    return c;
+}
+
+template<size_t _size>
+inline dual<_size> operator-(const interval& a, const dual<_size>& b) {
+    return -b + a;
+}
+
+/////////////////////////////
+// OPERATOR MULTIPLICATION //
+/////////////////////////////
+template<size_t _size>
+inline dual<_size> operator*(const dual<_size>& a, const dual<_size>& b) {
+    dual<_size> c(a.value() * b.value());
+    for (size_t k = 0; k < _size; ++k) {
+        c[k] = a[k] * b.value() + a.value() * b[k];
+    }
+    return c;
+}
+
+template<size_t _size>
+inline dual<_size> operator*(const dual<_size>& a, const interval& b) {
+    return detail::chain(a.value() * b, b, a);
+}
+
+template<size_t _size>
+inline dual<_size> operator*(const interval& a, const dual<_size>& b) {
+    return b * a;
+}
+
+template<size_t _size>
+inline dual<_size>& operator*=(dual<_size>& a, const dual<_size>& b) {
+    a = a * b;
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size>& operator*=(dual<_size>& a, const interval& b) {
+    a = a * b;
+    return a;
+}
+
+///////////////////////
+// OPERATOR DIVISION //
+///////////////////////
+template<size_t _size>
+inline dual<_size> operator/(const dual<_size>& a, const dual<_size>& b) {
+    // (a/b)' = (a' - (a/b)*b') / b
+    dual<_size> c(a.value() / b.value());
+    for (size_t k = 0; k < _size; ++k) {
+        c[k] = (a[k] - c.value() * b[k]) / b.value();
+    }
+    return c;
+}
+
+template<size_t _size>
+inline dual<_size> operator/(const dual<_size>& a, const interval& b) {
+    const interval r = 1.0 / b;
+    return detail::chain(a.value() * r, r, a);
+}
+
+template<size_t _size>
+inline dual<_size> operator/(const interval& a, const dual<_size>& b) {
+    const interval v = a / b.value();
+    return detail::chain(v, -v / b.value(), b);
+}
+
+template<size_t _size>
+inline dual<_size>& operator/=(dual<_size>& a, const dual<_size>& b) {
+    a = a / b;
+    return a;
+}
+
+template<size_t _size>
+inline dual<_size>& operator/=(dual<_size>& a, const interval& b) {
+    a = a / b;
+    return a;
+}
+
+//////////////////////////
+// ELEMENTARY FUNCTIONS //
+//////////////////////////
+template<size_t _size>
+inline dual<_size> sqr(const dual<_size>& a) {
+    return detail::chain(sqr(a.value()), 2 * a.value(), a);
+}
+
+template<size_t _size>
+inline dual<_size> sqrt(const dual<_size>& a) {
+    const interval v = sqrt(a.value());
+    return detail::chain(v, 0.5 / v, a);
+}
+
+template<size_t _size>
+inline dual<_size> abs(const dual<_size>& a) {
+    // Sign of the value, any slope in [-1,1] where it contains zero
+    interval s(-1, 1);
+    if (a.value().lower() > 0) {
+        s = interval(1);
+    } else if (a.value().upper() < 0) {
+        s = interval(-1);
+    }
+    return detail::chain(abs(a.value()), s, a);
+}
+
+template<size_t _size>
+inline dual<_size> exp(const dual<_size>& a) {
+    const interval v = exp(a.value());
+    return detail::chain(v, v, a);
+}
+
+template<size_t _size>
+inline dual<_size> log(const dual<_size>& a) {
+    return detail::chain(log(a.value()), 1.0 / a.value(), a);
+}
+
+template<size_t _size>
+inline dual<_size> sin(const dual<_size>& a) {
+    return detail::chain(sin(a.value()), cos(a.value()), a);
+}
+
+template<size_t _size>
+inline dual<_size> cos(const dual<_size>& a) {
+    return detail::chain(cos(a.value()), -sin(a.value()), a);
+}
+
+// Objective written once for any scalar type T, called with the
+// coordinates as std::array<T, _size>, e.g.
+//     struct rosenbrock {
+//         template<class T>
+//         T operator()(const std::array<T, 2>& x) const {
+//             return 100 * sqr(x[1] - sqr(x[0])) + sqr(x[0] - 1);
+//         }
+//     };
+// Calls with intervals bound the function, calls with duals bound the
+// function and its gradient in one pass.
+template<class F, size_t _size, class = void>
+struct is_objective : std::false_type {};
+
+template<class F, size_t _size>
+struct is_objective<F, _size, typename std::enable_if<std::is_convertible<
+    decltype(std::declval<const F&>()(
+        std::declval<const std::array<dual<_size>, _size>&>())),
+    dual<_size>>::value>::type> : std::true_type {};
+
+} // namespace rapidlab
+
+#endif
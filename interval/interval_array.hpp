@@ -0,0 +1,634 @@
+#ifndef RapidLab_interval_array_hpp
+#define RapidLab_interval_array_hpp
+
+#include "arithmetic.hpp"
+#include "packed.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace rapidlab {
+
+// Array of intervals stored as structure of arrays, negated lower bounds
+// and upper bounds in two separate aligned arrays. Elementwise operations
+// stream over both arrays using full SIMD registers, assuming the same
+// rounding mode (round up) as the scalar interval operators.
+class interval_array {
+public:
+#ifdef __AVX__
+    using reg = __m256d;
+#else
+    using reg = __m128d;
+#endif
+    // See the simd specializations on the attributes of reg
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+    using s = detail::simd<reg>;
+#pragma GCC diagnostic pop
+
+    interval_array() : n(0) {}
+    // Elements are left uninitialized
+    explicit interval_array(size_t size) { allocate(size); }
+    interval_array(size_t size, const interval& value) {
+        allocate(size);
+        std::fill(nl.get(), nl.get() + n, -value.lower());
+        std::fill(u.get(), u.get() + n, value.upper());
+    }
+    interval_array(const interval_array& a) {
+        allocate(a.n);
+        std::copy(a.nl.get(), a.nl.get() + padded(), nl.get());
+        std::copy(a.u.get(), a.u.get() + padded(), u.get());
+    }
+    interval_array(interval_array&& a) = default;
+
+    interval_array& operator=(interval_array a) {
+        std::swap(n, a.n);
+        std::swap(nl, a.nl);
+        std::swap(u, a.u);
+        return *this;
+    }
+
+    size_t size() const { return n; }
+
+    interval operator[](size_t i) const { return interval(-nl[i], u[i]); }
+    void set(size_t i, const interval& value) {
+        nl[i] = -value.lower();
+        u[i] = value.upper();
+    }
+
+    double lower(size_t i) const { return -nl[i]; }
+    double upper(size_t i) const { return u[i]; }
+
+    // Raw storage, padded to a multiple of the register width
+    const double* neg_lower_data() const { return nl.get(); }
+    const double* upper_data() const { return u.get(); }
+    double* neg_lower_data() { return nl.get(); }
+    double* upper_data() { return u.get(); }
+    size_t padded() const { return (n + s::lanes - 1) / s::lanes * s::lanes; }
+
+private:
+    struct aligned_free {
+        void operator()(double* p) const { _mm_free(p); }
+    };
+    using storage = std::unique_ptr<double[], aligned_free>;
+
+    size_t n;
+    storage nl;
+    storage u;
+
+    static const size_t alignment = 64;
+
+    static storage make_storage(size_t count) {
+        void* p = _mm_malloc(std::max<size_t>(count, 1) * sizeof(double), alignment);
+        if (!p) throw std::bad_alloc();
+        return storage(static_cast<double*>(p));
+    }
+
+    void allocate(size_t size) {
+        n = size;
+        nl = make_storage(padded());
+        u = make_storage(padded());
+        // Padding holds zero intervals, harmless to every kernel
+        std::fill(nl.get() + n, nl.get() + padded(), -0.0);
+        std::fill(u.get() + n, u.get() + padded(), 0.0);
+    }
+};
+
+namespace detail {
+
+// Operands of the streaming kernels, either an array or a broadcast interval
+struct array_operand {
+    const double* nl;
+    const double* u;
+    array_operand(const interval_array& a)
+    : nl(a.neg_lower_data()), u(a.upper_data()) {}
+    interval_array::reg neg_lower(size_t i) const {
+        return interval_array::s::load_pd(nl + i);
+    }
+    interval_array::reg upper(size_t i) const {
+        return interval_array::s::load_pd(u + i);
+    }
+};
+
+struct scalar_operand {
+    interval_array::reg nl;
+    interval_array::reg u;
+    scalar_operand(const interval& a)
+    : nl(interval_array::s::set1(-a.lower())),
+      u(interval_array::s::set1(a.upper())) {}
+    interval_array::reg neg_lower(size_t) const { return nl; }
+    interval_array::reg upper(size_t) const { return u; }
+};
+
+// Applies kernel f(nl_a, u_a, nl_b, u_b, nl_c, u_c) register by register,
+// c may be one of the operands
+template<class A, class B, class F>
+inline void a_apply(const A& a, const B& b, F f, interval_array& c) {
+    using s = interval_array::s;
+    check_rounding<rounding::upward>();
+    double* nl = c.neg_lower_data();
+    double* u = c.upper_data();
+    const size_t end = c.padded();
+    for (size_t i = 0; i < end; i += s::lanes) {
+        interval_array::reg r_nl, r_u;
+        f(a.neg_lower(i), a.upper(i), b.neg_lower(i), b.upper(i), r_nl, r_u);
+        s::store_pd(nl + i, r_nl);
+        s::store_pd(u + i, r_u);
+    }
+}
+
+template<class F>
+inline void a_apply(const interval_array& a, F f, interval_array& c) {
+    using s = interval_array::s;
+    check_rounding<rounding::upward>();
+    const double* a_nl = a.neg_lower_data();
+    const double* a_u = a.upper_data();
+    double* nl = c.neg_lower_data();
+    double* u = c.upper_data();
+    const size_t end = c.padded();
+    for (size_t i = 0; i < end; i += s::lanes) {
+        interval_array::reg r_nl, r_u;
+        f(s::load_pd(a_nl + i), s::load_pd(a_u + i), r_nl, r_u);
+        s::store_pd(nl + i, r_nl);
+        s::store_pd(u + i, r_u);
+    }
+}
+
+struct a_add {
+    template<class R>
+    void operator()(R nla, R ua, R nlb, R ub, R& nl, R& u) const {
+        using s = simd<R>;
+        nl = s::add(nla, nlb);
+        u = s::add(ua, ub);
+    }
+};
+
+struct a_sub {
+    template<class R>
+    void operator()(R nla, R ua, R nlb, R ub, R& nl, R& u) const {
+        using s = simd<R>;
+        nl = s::add(nla, ub);
+        u = s::add(ua, nlb);
+    }
+};
+
+struct a_mul {
+    template<class R>
+    void operator()(R nla, R ua, R nlb, R ub, R& nl, R& u) const {
+        using s = simd<R>;
+        const R sign = s::set1(-0.0);
+        const R la = s::bit_xor(nla, sign);
+        const R mua = s::bit_xor(ua, sign);
+        // Each candidate product rounded up, as for packed intervals
+        nl = s::max(s::max(s::mul(nla, ub), s::mul(ua, nlb)),
+                    s::max(s::mul(la, nlb), s::mul(mua, ub)));
+        u = s::max(s::max(s::mul(nla, nlb), s::mul(ua, ub)),
+                   s::max(s::mul(la, ub), s::mul(mua, nlb)));
+    }
+};
+
+struct a_div {
+    template<class R>
+    void operator()(R nla, R ua, R nlb, R ub, R& nl, R& u) const {
+        using s = simd<R>;
+        // Reciprocal of b, entire real line if b contains zero
+        const R zero = s::set1(0.0);
+        const R spans_zero = s::bit_and(s::cmple(zero, nlb), s::cmple(zero, ub));
+        R nl_r = s::div(s::set1(-1.0), ub);
+        R u_r = s::div(s::set1(-1.0), nlb);
+        nl_r = s::blend(nl_r, s::set1(INFINITY), spans_zero);
+        u_r = s::blend(u_r, s::set1(INFINITY), spans_zero);
+        a_mul()(nla, ua, nl_r, u_r, nl, u);
+    }
+};
+
+struct a_sqr {
+    template<class R>
+    void operator()(R nla, R ua, R& nl, R& u) const {
+        using s = simd<R>;
+        const R sign = s::set1(-0.0);
+        const R zero = s::set1(0.0);
+        const R spans_zero = s::bit_and(s::cmple(zero, nla), s::cmple(zero, ua));
+        u = s::max(s::mul(nla, nla), s::mul(ua, ua));
+        nl = s::max(s::mul(s::bit_xor(nla, sign), nla),
+                    s::mul(s::bit_xor(ua, sign), ua));
+        nl = s::blend(nl, sign, spans_zero);
+    }
+};
+
+struct a_sqrt {
+    template<class R>
+    void operator()(R nla, R ua, R& nl, R& u) const {
+        using s = simd<R>;
+        // Two roundings to counteract with multiply, as in scalar sqrt
+        nl = s::bit_xor(s::sqrt(s::mul(nla, s::set1(-0x1.ffffffffffff8p-1))),
+                        s::set1(-0.0));
+        u = s::sqrt(ua);
+        const R negative = s::cmplt(s::set1(0.0), nla);
+        nl = s::blend(nl, s::set1(NAN), negative);
+        u = s::blend(u, s::set1(NAN), negative);
+    }
+};
+
+// Elementary functions of the bounds, evaluated rounding upward by range
+// reduction and Taylor polynomials. a_exp_point and a_log_point are within
+// a_relative_error of the exact value relative to it, a_trig_point within
+// a_absolute_error of it. Horner's scheme with directed rounding errs by at
+// most 2n ulps of the sum of the absolute terms, some 55 ulps of the value
+// for exp and log and 40 ulps of 1 for sine and cosine, and the reduced
+// arguments carry a few more; the bounds below allow 128 ulps.
+static const double a_relative_error = 0x1p-45;
+static const double a_absolute_error = 0x1p-45;
+
+// Integer above x for |x| < 2^51, what adding 1.5*2^52 gives rounding up
+template<class R>
+inline R a_ceil(R x) {
+    using s = simd<R>;
+    const R magic = s::set1(0x1.8p52);
+    return s::add(s::add(x, magic), s::set1(-0x1.8p52));
+}
+
+template<class R, size_t _n>
+inline R a_horner(R x, const double (&c)[_n]) {
+    using s = simd<R>;
+    R p = s::set1(c[_n - 1]);
+    for (size_t i = _n - 1; i-- > 0;) {
+        p = s::add(s::mul(p, x), s::set1(c[i]));
+    }
+    return p;
+}
+
+// exp(x) of x in [-708, 709] as 2^k exp(r), |r| <= ln(2)/2, with ln(2)
+// split in two so that k ln(2) is exact in its first part
+template<class R>
+inline R a_exp_point(R x) {
+    using s = simd<R>;
+    static const double c[] = {
+        1.0, 1.0, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720,
+        1.0 / 5040, 1.0 / 40320, 1.0 / 362880, 1.0 / 3628800,
+        1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800};
+    const R k = a_ceil(s::add(s::mul(x, s::set1(1.4426950408889634)),
+                              s::set1(-0.5)));
+    R r = s::add(x, s::mul(k, s::set1(-6.93147180369123816490e-01)));
+    r = s::add(r, s::mul(k, s::set1(-1.90821492927058770002e-10)));
+    return s::mul(a_horner(r, c), s::pow2(k));
+}
+
+// log(x) of positive finite x as e ln(2) + log(m), m in [sqrt(1/2),
+// sqrt(2)), with log(m) = 2 atanh(z) of z = (m - 1) / (m + 1)
+template<class R>
+inline R a_log_point(R x) {
+    using s = simd<R>;
+    static const double c[] = {
+        1.0, 1.0 / 3, 1.0 / 5, 1.0 / 7, 1.0 / 9, 1.0 / 11, 1.0 / 13,
+        1.0 / 15, 1.0 / 17, 1.0 / 19, 1.0 / 21};
+    //subnormal numbers scaled to normal ones
+    const R subnormal = s::cmplt(x, s::set1(0x1p-1022));
+    x = s::blend(x, s::mul(x, s::set1(0x1p54)), subnormal);
+    R e = s::add(s::exponent(x),
+                 s::bit_and(subnormal, s::set1(-54.0)));
+    R m = s::mantissa(x);
+    const R above = s::cmplt(s::set1(1.4142135623730951), m);
+    m = s::blend(m, s::mul(m, s::set1(0.5)), above);
+    e = s::add(e, s::bit_and(above, s::set1(1.0)));
+
+    const R z = s::div(s::add(m, s::set1(-1.0)), s::add(m, s::set1(1.0)));
+    const R log_m = s::mul(s::mul(z, s::set1(2.0)),
+                           a_horner(s::mul(z, z), c));
+    const R tail = s::add(s::mul(e, s::set1(1.90821492927058770002e-10)),
+                          log_m);
+    return s::add(s::mul(e, s::set1(6.93147180369123816490e-01)), tail);
+}
+
+// cos(x + quadrant pi/2) of |x| <= 2^20 by reduction to |r| <= pi/4, with
+// pi/2 split in three so that the first two products are exact
+template<class R>
+inline R a_trig_point(R x, double quadrant) {
+    using s = simd<R>;
+    static const double sin_c[] = {
+        1.0, -1.0 / 6, 1.0 / 120, -1.0 / 5040, 1.0 / 362880,
+        -1.0 / 39916800, 1.0 / 6227020800, -1.0 / 1307674368000};
+    static const double cos_c[] = {
+        1.0, -1.0 / 2, 1.0 / 24, -1.0 / 720, 1.0 / 40320, -1.0 / 3628800,
+        1.0 / 479001600, -1.0 / 87178291200, 1.0 / 20922789888000};
+    const R q = a_ceil(s::add(s::mul(x, s::set1(0.63661977236758134)),
+                              s::set1(-0.5)));
+    R r = s::add(x, s::mul(q, s::set1(-1.57079632673412561417e+00)));
+    r = s::add(r, s::mul(q, s::set1(-6.07710050630396597660e-11)));
+    r = s::add(r, s::mul(q, s::set1(-2.02226624871116645580e-21)));
+    const R z = s::mul(r, r);
+    const R sin_r = s::mul(r, a_horner(z, sin_c));
+    const R cos_r = a_horner(z, cos_c);
+
+    //quadrant of x + quadrant pi/2 modulo 4, cos, -sin, -cos, sin of r
+    R k = s::add(q, s::set1(quadrant));
+    k = s::add(k, s::mul(s::set1(4.0), a_ceil(s::mul(k, s::set1(-0.25)))));
+    const R h = s::mul(k, s::set1(0.5));
+    const R odd = s::cmplt(h, a_ceil(h));
+    const R negative = s::bit_and(s::cmplt(s::set1(0.5), k),
+                                  s::cmplt(k, s::set1(2.5)));
+    const R v = s::blend(cos_r, sin_r, odd);
+    return s::bit_xor(v, s::bit_and(negative, s::set1(-0.0)));
+}
+
+struct a_exp {
+    template<class R>
+    void operator()(R nla, R ua, R& nl, R& u) const {
+        using s = simd<R>;
+        const R sign = s::set1(-0.0);
+        const R low = s::set1(-708.0);
+        const R high = s::set1(709.0);
+        //max and min keep a nan operand in their second argument
+        const R l = s::bit_xor(nla, sign);
+        const R el = a_exp_point(s::min(high, s::max(low, l)));
+        const R eu = a_exp_point(s::min(high, s::max(low, ua)));
+        const R error = s::set1(a_relative_error);
+        nl = s::add(s::bit_xor(el, sign), s::mul(el, error));
+        u = s::add(eu, s::mul(eu, error));
+        //below the range exp is positive, above it unbounded
+        nl = s::blend(nl, sign, s::cmplt(l, low));
+        u = s::blend(u, s::set1(INFINITY), s::cmplt(high, ua));
+    }
+};
+
+struct a_log {
+    template<class R>
+    void operator()(R nla, R ua, R& nl, R& u) const {
+        using s = simd<R>;
+        const R sign = s::set1(-0.0);
+        const R zero = s::set1(0.0);
+        const R inf = s::set1(INFINITY);
+        const R error = s::set1(a_relative_error);
+        const R l = s::bit_xor(nla, sign);
+        const R ll = a_log_point(l);
+        const R lu = a_log_point(ua);
+        nl = s::add(s::bit_xor(ll, sign),
+                    s::mul(s::bit_andnot(sign, ll), error));
+        u = s::add(lu, s::mul(s::bit_andnot(sign, lu), error));
+        //log(0) is -inf, log(inf) inf, and negative arguments have none
+        nl = s::blend(nl, inf, s::cmple(l, zero));
+        nl = s::blend(nl, s::set1(-INFINITY), s::cmple(inf, l));
+        u = s::blend(u, s::set1(-INFINITY), s::cmple(ua, zero));
+        u = s::blend(u, inf, s::cmple(inf, ua));
+        const R none = s::bit_or(s::cmplt(ua, zero), s::cmpunord(nla, ua));
+        nl = s::blend(nl, s::set1(NAN), none);
+        u = s::blend(u, s::set1(NAN), none);
+    }
+};
+
+// Bounds of cos(x + quadrant pi/2) over the interval: the values at both
+// ends, raised to 1 if it holds a maximum and lowered to -1 if it holds a
+// minimum. These lie where x/pi - phase is an even or odd integer, found
+// from outward bounds of l/pi and u/pi. Intervals beyond 2^20 get [-1, 1].
+template<class R>
+inline void a_trig(R nla, R ua, double phase, double quadrant,
+                   R& nl, R& u) {
+    using s = simd<R>;
+    const R sign = s::set1(-0.0);
+    const R one = s::set1(1.0);
+    const R pi_l = s::set1(pi_lower());
+    const R pi_u = s::set1(pi_upper());
+    const R l = s::bit_xor(nla, sign);
+
+    //a <= l/pi - phase and u/pi - phase <= b, rounding upward
+    const R zero = s::set1(0.0);
+    R a = s::div(nla, s::blend(pi_l, pi_u, s::cmple(nla, zero)));
+    a = s::bit_xor(s::add(a, s::set1(phase)), sign);
+    R b = s::div(ua, s::blend(pi_u, pi_l, s::cmple(zero, ua)));
+    b = s::add(b, s::set1(-phase));
+    const R j = a_ceil(a);
+    const R next = s::add(j, one);
+    const R h = s::mul(j, s::set1(0.5));
+    const R j_odd = s::cmplt(h, a_ceil(h));
+    const R has_j = s::cmple(j, b);
+    const R has_next = s::cmple(next, b);
+    const R has_max = s::bit_or(s::bit_andnot(j_odd, has_j),
+                                s::bit_and(j_odd, has_next));
+    const R has_min = s::bit_or(s::bit_and(j_odd, has_j),
+                                s::bit_andnot(j_odd, has_next));
+
+    const R range = s::set1(0x1p20);
+    const R cl = a_trig_point(s::min(range, s::max(s::bit_xor(range, sign), l)),
+                              quadrant);
+    const R cu = a_trig_point(s::min(range, s::max(s::bit_xor(range, sign), ua)),
+                              quadrant);
+    const R error = s::set1(a_absolute_error);
+    u = s::min(s::add(s::max(cl, cu), error), one);
+    nl = s::min(s::add(s::max(s::bit_xor(cl, sign), s::bit_xor(cu, sign)),
+                       error), one);
+    u = s::blend(u, one, has_max);
+    nl = s::blend(nl, one, has_min);
+
+    const R large = s::bit_or(s::cmplt(range, nla), s::cmplt(range, ua));
+    u = s::blend(u, one, large);
+    nl = s::blend(nl, one, large);
+    const R none = s::cmpunord(nla, ua);
+    u = s::blend(u, s::set1(NAN), none);
+    nl = s::blend(nl, s::set1(NAN), none);
+}
+
+struct a_cos {
+    template<class R>
+    void operator()(R nla, R ua, R& nl, R& u) const {
+        a_trig(nla, ua, 0.0, 0.0, nl, u);
+    }
+};
+
+// sin(x) = cos(x - pi/2), maxima where x/pi - 1/2 is even
+struct a_sin {
+    template<class R>
+    void operator()(R nla, R ua, R& nl, R& u) const {
+        a_trig(nla, ua, 0.5, 3.0, nl, u);
+    }
+};
+
+} // namespace detail
+
+///////////////////////////
+// ELEMENTWISE OPERATORS //
+///////////////////////////
+// Operators on temporaries reuse their storage for the result
+#define RAPIDLAB_ARRAY_OPERATOR(op, kernel) \
+inline interval_array operator op(const interval_array& a, const interval_array& b) { \
+    assert(a.size() == b.size() && "interval arrays differ in size"); \
+    interval_array c(a.size()); \
+    detail::a_apply(detail::array_operand(a), detail::array_operand(b), \
+                    detail::kernel(), c); \
+    return c; \
+} \
+inline interval_array operator op(interval_array&& a, const interval_array& b) { \
+    assert(a.size() == b.size() && "interval arrays differ in size"); \
+    detail::a_apply(detail::array_operand(a), detail::array_operand(b), \
+                    detail::kernel(), a); \
+    return std::move(a); \
+} \
+inline interval_array operator op(const interval_array& a, interval_array&& b) { \
+    assert(a.size() == b.size() && "interval arrays differ in size"); \
+    detail::a_apply(detail::array_operand(a), detail::array_operand(b), \
+                    detail::kernel(), b); \
+    return std::move(b); \
+} \
+inline interval_array operator op(interval_array&& a, interval_array&& b) { \
+    return std::move(a) op static_cast<const interval_array&>(b); \
+} \
+inline interval_array operator op(const interval_array& a, const interval& b) { \
+    interval_array c(a.size()); \
+    detail::a_apply(detail::array_operand(a), detail::scalar_operand(b), \
+                    detail::kernel(), c); \
+    return c; \
+} \
+inline interval_array operator op(interval_array&& a, const interval& b) { \
+    detail::a_apply(detail::array_operand(a), detail::scalar_operand(b), \
+                    detail::kernel(), a); \
+    return std::move(a); \
+} \
+inline interval_array operator op(const interval& a, const interval_array& b) { \
+    interval_array c(b.size()); \
+    detail::a_apply(detail::scalar_operand(a), detail::array_operand(b), \
+                    detail::kernel(), c); \
+    return c; \
+} \
+inline interval_array operator op(const interval& a, interval_array&& b) { \
+    detail::a_apply(detail::scalar_operand(a), detail::array_operand(b), \
+                    detail::kernel(), b); \
+    return std::move(b); \
+} \
+inline interval_array& operator op##=(interval_array& a, const interval_array& b) { \
+    assert(a.size() == b.size() && "interval arrays differ in size"); \
+    detail::a_apply(detail::array_operand(a), detail::array_operand(b), \
+                    detail::kernel(), a); \
+    return a; \
+} \
+inline interval_array& operator op##=(interval_array& a, const interval& b) { \
+    detail::a_apply(detail::array_operand(a), detail::scalar_operand(b), \
+                    detail::kernel(), a); \
+    return a; \
+}
+
+RAPIDLAB_ARRAY_OPERATOR(+, a_add)
+RAPIDLAB_ARRAY_OPERATOR(-, a_sub)
+RAPIDLAB_ARRAY_OPERATOR(*, a_mul)
+RAPIDLAB_ARRAY_OPERATOR(/, a_div)
+
+#undef RAPIDLAB_ARRAY_OPERATOR
+
+inline interval_array operator-(const interval_array& a) {
+    return interval(0) - a;
+}
+
+inline interval_array operator-(interval_array&& a) {
+    return interval(0) - std::move(a);
+}
+
+inline interval_array sqr(const interval_array& a) {
+    interval_array c(a.size());
+    detail::a_apply(a, detail::a_sqr(), c);
+    return c;
+}
+
+inline interval_array sqr(interval_array&& a) {
+    detail::a_apply(a, detail::a_sqr(), a);
+    return std::move(a);
+}
+
+inline interval_array sqrt(const interval_array& a) {
+    interval_array c(a.size());
+    detail::a_apply(a, detail::a_sqrt(), c);
+    return c;
+}
+
+inline interval_array sqrt(interval_array&& a) {
+    detail::a_apply(a, detail::a_sqrt(), a);
+    return std::move(a);
+}
+
+// Transcendental functions, wider than the scalar ones by the error bounds
+// of the polynomial kernels
+#define RAPIDLAB_ARRAY_FUNCTION(name, kernel) \
+inline interval_array name(const interval_array& a) { \
+    interval_array c(a.size()); \
+    detail::a_apply(a, detail::kernel(), c); \
+    return c; \
+} \
+inline interval_array name(interval_array&& a) { \
+    detail::a_apply(a, detail::kernel(), a); \
+    return std::move(a); \
+}
+
+RAPIDLAB_ARRAY_FUNCTION(exp, a_exp)
+RAPIDLAB_ARRAY_FUNCTION(log, a_log)
+RAPIDLAB_ARRAY_FUNCTION(sin, a_sin)
+RAPIDLAB_ARRAY_FUNCTION(cos, a_cos)
+
+#undef RAPIDLAB_ARRAY_FUNCTION
+
+////////////////
+// REDUCTIONS //
+////////////////
+namespace detail {
+
+// Reduces negated lower and upper bounds with max or min separately
+template<class FL, class FU>
+inline interval a_reduce(const interval_array& a, FL f_nl, FU f_u) {
+    using s = interval_array::s;
+    assert(a.size() > 0 && "cannot reduce an empty interval array");
+    const double* nl = a.neg_lower_data();
+    const double* u = a.upper_data();
+    const size_t full = a.size() / s::lanes * s::lanes;
+
+    double r_nl = nl[0];
+    double r_u = u[0];
+    if (full > 0) {
+        interval_array::reg v_nl = s::load_pd(nl);
+        interval_array::reg v_u = s::load_pd(u);
+        for (size_t i = s::lanes; i < full; i += s::lanes) {
+            v_nl = f_nl(v_nl, s::load_pd(nl + i));
+            v_u = f_u(v_u, s::load_pd(u + i));
+        }
+        alignas(32) double t_nl[s::lanes], t_u[s::lanes];
+        s::store_pd(t_nl, v_nl);
+        s::store_pd(t_u, v_u);
+        for (size_t k = 0; k < s::lanes; ++k) {
+            r_nl = f_nl(r_nl, t_nl[k]);
+            r_u = f_u(r_u, t_u[k]);
+        }
+    }
+    for (size_t i = full; i < a.size(); ++i) {
+        r_nl = f_nl(r_nl, nl[i]);
+        r_u = f_u(r_u, u[i]);
+    }
+    return interval(-r_nl, r_u);
+}
+
+struct a_max {
+    double operator()(double a, double b) const { return std::max(a, b); }
+    template<class R> R operator()(R a, R b) const { return simd<R>::max(a, b); }
+};
+
+struct a_min {
+    double operator()(double a, double b) const { return std::min(a, b); }
+    template<class R> R operator()(R a, R b) const { return simd<R>::min(a, b); }
+};
+
+} // namespace detail
+
+// Smallest interval containing all elements
+inline interval hull(const interval_array& a) {
+    return detail::a_reduce(a, detail::a_max(), detail::a_max());
+}
+
+// Elementwise minimum over all elements, [min lower, min upper]
+inline interval min(const interval_array& a) {
+    return detail::a_reduce(a, detail::a_max(), detail::a_min());
+}
+
+// Elementwise maximum over all elements, [max lower, max upper]
+inline interval max(const interval_array& a) {
+    return detail::a_reduce(a, detail::a_min(), detail::a_max());
+}
+
+} // namespace rapidlab
+
+#endif
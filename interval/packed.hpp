@@ -0,0 +1,530 @@
+#ifndef RapidLab_packed_hpp
+#define RapidLab_packed_hpp
+
+#include "interval.hpp"
+#include "rounding.hpp"
+
+#include <immintrin.h>
+
+#include <array>
+#include <cmath>
+
+namespace rapidlab {
+
+namespace detail {
+
+// Register operations used by the packed interval kernels. Every register
+// holds whole intervals stored as (-lower, upper) pairs, like interval.
+template<class R> struct simd;
+
+// Template arguments drop the may_alias attribute of the vector types,
+// the kernels never rely on it as they load and store through intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+template<> struct simd<__m128d> {
+    using reg = __m128d;
+    // Number of intervals and doubles per register
+    static const size_t width = 1;
+    static const size_t lanes = 2;
+
+    static reg load_pd(const double* p) { return _mm_load_pd(p); }
+    static void store_pd(double* p, reg x) { _mm_store_pd(p, x); }
+
+    static reg load(const interval* p) { return p->value(); }
+    static void store(interval* p, reg x) { p->value() = x; }
+    static reg set1(double d) { return _mm_set1_pd(d); }
+    static reg set_interval(const interval& a) { return a.value(); }
+
+    static reg add(reg x, reg y) { return _mm_add_pd(x, y); }
+    static reg mul(reg x, reg y) { return _mm_mul_pd(x, y); }
+    static reg div(reg x, reg y) { return _mm_div_pd(x, y); }
+    static reg sqrt(reg x) { return _mm_sqrt_pd(x); }
+    static reg max(reg x, reg y) { return _mm_max_pd(x, y); }
+    static reg min(reg x, reg y) { return _mm_min_pd(x, y); }
+    static reg bit_and(reg x, reg y) { return _mm_and_pd(x, y); }
+    static reg bit_xor(reg x, reg y) { return _mm_xor_pd(x, y); }
+    static reg bit_andnot(reg x, reg y) { return _mm_andnot_pd(x, y); }
+    static reg cmple(reg x, reg y) { return _mm_cmple_pd(x, y); }
+    static reg cmplt(reg x, reg y) { return _mm_cmplt_pd(x, y); }
+    static reg bit_or(reg x, reg y) { return _mm_or_pd(x, y); }
+    static reg cmpunord(reg x, reg y) { return _mm_cmpunord_pd(x, y); }
+
+    // 2^k of integral k in [-1022, 1023]
+    static reg pow2(reg k) {
+        __m128i e = _mm_castpd_si128(_mm_add_pd(k, _mm_set1_pd(0x1p52 + 1023)));
+        return _mm_castsi128_pd(_mm_slli_epi64(e, 52));
+    }
+    // Exponent of positive normal x, unbiased
+    static reg exponent(reg x) {
+        __m128i e = _mm_srli_epi64(_mm_castpd_si128(x), 52);
+        reg b = _mm_or_pd(_mm_castsi128_pd(e), _mm_set1_pd(0x1p52));
+        return _mm_sub_pd(b, _mm_set1_pd(0x1p52 + 1023));
+    }
+    // Significand of positive normal x, in [1, 2)
+    static reg mantissa(reg x) {
+        reg m = _mm_castsi128_pd(_mm_set1_epi64x(0x000fffffffffffffLL));
+        return _mm_or_pd(_mm_and_pd(x, m), _mm_set1_pd(1.0));
+    }
+
+    // (upper, -lower) of every interval
+    static reg swap(reg x) { return _mm_shuffle_pd(x, x, 1); }
+    // (-lower, -lower) of every interval
+    static reg dup_lower(reg x) { return _mm_unpacklo_pd(x, x); }
+    // (upper, upper) of every interval
+    static reg dup_upper(reg x) { return _mm_unpackhi_pd(x, x); }
+    // Select y where mask is set, x elsewhere
+    static reg blend(reg x, reg y, reg mask) {
+        return _mm_or_pd(_mm_and_pd(mask, y), _mm_andnot_pd(mask, x));
+    }
+    // Lower bound slot taken from x, upper bound slot taken from y
+    static reg merge(reg x, reg y) { return _mm_move_sd(y, x); }
+    // One bit per interval, set if the mask is set for both bounds
+    static int movemask_all(reg mask) {
+        return _mm_movemask_pd(mask) == 3;
+    }
+};
+
+#ifdef __AVX__
+template<> struct simd<__m256d> {
+    using reg = __m256d;
+    static const size_t width = 2;
+    static const size_t lanes = 4;
+
+    static reg load_pd(const double* p) { return _mm256_load_pd(p); }
+    static void store_pd(double* p, reg x) { _mm256_store_pd(p, x); }
+
+    static reg load(const interval* p) {
+        return _mm256_loadu_pd(reinterpret_cast<const double*>(p));
+    }
+    static void store(interval* p, reg x) {
+        _mm256_storeu_pd(reinterpret_cast<double*>(p), x);
+    }
+    static reg set1(double d) { return _mm256_set1_pd(d); }
+    static reg set_interval(const interval& a) {
+        return _mm256_broadcast_pd(&a.value());
+    }
+
+    static reg add(reg x, reg y) { return _mm256_add_pd(x, y); }
+    static reg mul(reg x, reg y) { return _mm256_mul_pd(x, y); }
+    static reg div(reg x, reg y) { return _mm256_div_pd(x, y); }
+    static reg sqrt(reg x) { return _mm256_sqrt_pd(x); }
+    static reg max(reg x, reg y) { return _mm256_max_pd(x, y); }
+    static reg min(reg x, reg y) { return _mm256_min_pd(x, y); }
+    static reg bit_and(reg x, reg y) { return _mm256_and_pd(x, y); }
+    static reg bit_xor(reg x, reg y) { return _mm256_xor_pd(x, y); }
+    static reg bit_andnot(reg x, reg y) { return _mm256_andnot_pd(x, y); }
+    static reg cmple(reg x, reg y) { return _mm256_cmp_pd(x, y, _CMP_LE_OQ); }
+    static reg cmplt(reg x, reg y) { return _mm256_cmp_pd(x, y, _CMP_LT_OQ); }
+    static reg bit_or(reg x, reg y) { return _mm256_or_pd(x, y); }
+    static reg cmpunord(reg x, reg y) {
+        return _mm256_cmp_pd(x, y, _CMP_UNORD_Q);
+    }
+
+    // Integer operations by halves, AVX has no 256 bit integer shifts
+    static reg pow2(reg k) {
+        using h = simd<__m128d>;
+        return halves(h::pow2(low(k)), h::pow2(high(k)));
+    }
+    static reg exponent(reg x) {
+        using h = simd<__m128d>;
+        return halves(h::exponent(low(x)), h::exponent(high(x)));
+    }
+    static reg mantissa(reg x) {
+        reg m = _mm256_castsi256_pd(_mm256_set1_epi64x(0x000fffffffffffffLL));
+        return _mm256_or_pd(_mm256_and_pd(x, m), _mm256_set1_pd(1.0));
+    }
+    static __m128d low(reg x) { return _mm256_castpd256_pd128(x); }
+    static __m128d high(reg x) { return _mm256_extractf128_pd(x, 1); }
+    static reg halves(__m128d l, __m128d h) {
+        return _mm256_insertf128_pd(_mm256_castpd128_pd256(l), h, 1);
+    }
+
+    static reg swap(reg x) { return _mm256_permute_pd(x, 0x5); }
+    static reg dup_lower(reg x) { return _mm256_movedup_pd(x); }
+    static reg dup_upper(reg x) { return _mm256_permute_pd(x, 0xf); }
+    static reg blend(reg x, reg y, reg mask) {
+        return _mm256_blendv_pd(x, y, mask);
+    }
+    static reg merge(reg x, reg y) { return _mm256_blend_pd(x, y, 0xa); }
+    static int movemask_all(reg mask) {
+        int m = _mm256_movemask_pd(mask);
+        return ((m & 3) == 3) | (((m >> 2) & 3) == 3) << 1;
+    }
+};
+#endif
+#pragma GCC diagnostic pop
+
+// Branch-free interval kernels on whole registers, rounding mode
+// must be set to round up as for the scalar operators
+template<class R>
+inline R p_neg(R x) {
+    return simd<R>::swap(x);
+}
+
+template<class R>
+inline R p_add(R x, R y) {
+    return simd<R>::add(x, y);
+}
+
+template<class R>
+inline R p_mul(R x, R y) {
+    using s = simd<R>;
+    const R sign = s::set1(-0.0);
+    // Both -lower and upper are the maximum of four products of the
+    // stored bounds with signs flipped, each of them rounded up
+    R a = s::mul(x, s::dup_upper(y));
+    R b = s::mul(s::swap(x), s::dup_lower(y));
+    R c = s::mul(s::bit_xor(s::dup_lower(x), sign), y);
+    R d = s::mul(s::bit_xor(s::dup_upper(x), sign), s::swap(y));
+    return s::max(s::max(a, b), s::max(c, d));
+}
+
+template<class R>
+inline R p_zero_in_mask(R x) {
+    using s = simd<R>;
+    R mask = s::cmple(s::set1(0.0), x);
+    return s::bit_and(mask, s::swap(mask));
+}
+
+template<class R>
+inline R p_recip(R x) {
+    using s = simd<R>;
+    R r = s::div(s::set1(-1.0), s::swap(x));
+    // Interval spans over zero
+    return s::blend(r, s::set1(INFINITY), p_zero_in_mask(x));
+}
+
+template<class R>
+inline R p_sqr(R x) {
+    using s = simd<R>;
+    const R sign = s::set1(-0.0);
+    R sq = s::mul(x, x);
+    R neg_sq = s::mul(s::bit_xor(x, sign), x);
+    R upper = s::max(sq, s::swap(sq));
+    R lower = s::max(neg_sq, s::swap(neg_sq));
+    // Interval contains zero
+    lower = s::blend(lower, sign, p_zero_in_mask(x));
+    return s::merge(lower, upper);
+}
+
+template<class R>
+inline R p_sqrt(R x) {
+    using s = simd<R>;
+    // Two roundings to counteract with multiply, as in scalar sqrt
+    R f = s::merge(s::set1(-0x1.ffffffffffff8p-1), s::set1(1.0));
+    R r = s::sqrt(s::mul(x, f));
+    r = s::bit_xor(r, s::merge(s::set1(-0.0), s::set1(0.0)));
+    // Lower bound below zero
+    R negative = s::cmplt(s::set1(0.0), s::dup_lower(x));
+    return s::blend(r, s::set1(NAN), negative);
+}
+
+template<class R>
+inline R p_abs(R x) {
+    using s = simd<R>;
+    R sx = s::swap(x);
+    R magnitude = s::bit_andnot(s::set1(-0.0), x);
+    R upper = s::max(magnitude, s::swap(magnitude));
+    R lower = s::min(s::min(x, sx), s::set1(0.0));
+    return s::merge(lower, upper);
+}
+
+template<class R>
+inline R p_intersect(R x, R y) {
+    using s = simd<R>;
+    R r = s::min(x, y);
+    // Empty when lower > upper, i.e. -(-lower) > upper
+    R empty = s::cmplt(s::swap(r), s::bit_xor(r, s::set1(-0.0)));
+    return s::blend(r, s::set1(NAN), empty);
+}
+
+} // namespace detail
+
+// Several intervals packed into _regs registers of type R. All operations
+// work on every interval at once without branching on the values.
+template<class R, size_t _regs>
+class packed_interval {
+private:
+    using s = detail::simd<R>;
+    R v[_regs];
+
+public:
+    static const size_t size = _regs * s::width;
+
+    packed_interval() {
+        for (size_t i = 0; i < _regs; ++i) v[i] = s::set_interval(interval());
+    }
+    packed_interval(double a) {
+        for (size_t i = 0; i < _regs; ++i) v[i] = s::set_interval(interval(a));
+    }
+    packed_interval(const interval& a) {
+        for (size_t i = 0; i < _regs; ++i) v[i] = s::set_interval(a);
+    }
+    // Load size consecutive intervals, e.g. one coordinate of a box_block
+    explicit packed_interval(const interval* p) {
+        for (size_t i = 0; i < _regs; ++i) v[i] = s::load(p + i * s::width);
+    }
+
+    void store(interval* p) const {
+        for (size_t i = 0; i < _regs; ++i) s::store(p + i * s::width, v[i]);
+    }
+
+    interval operator[](size_t k) const {
+        interval r[size];
+        store(r);
+        return r[k];
+    }
+
+    const R& reg(size_t i) const { return v[i]; }
+    R& reg(size_t i) { return v[i]; }
+};
+
+template<class R, size_t _regs>
+const size_t packed_interval<R, _regs>::size;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-attributes"
+#ifdef __AVX__
+using interval_x2 = packed_interval<__m256d, 1>;
+using interval_x4 = packed_interval<__m256d, 2>;
+#else
+using interval_x2 = packed_interval<__m128d, 2>;
+using interval_x4 = packed_interval<__m128d, 4>;
+#endif
+#pragma GCC diagnostic pop
+
+namespace detail {
+
+// Packed kernels always round upward
+template<class R, size_t _regs, class F>
+inline packed_interval<R, _regs> p_apply(
+    const packed_interval<R, _regs>& a, F f) {
+    check_rounding<rounding::upward>();
+    packed_interval<R, _regs> c;
+    for (size_t i = 0; i < _regs; ++i) c.reg(i) = f(a.reg(i));
+    return c;
+}
+
+template<class R, size_t _regs, class F>
+inline packed_interval<R, _regs> p_apply(
+    const packed_interval<R, _regs>& a,
+    const packed_interval<R, _regs>& b, F f) {
+    check_rounding<rounding::upward>();
+    packed_interval<R, _regs> c;
+    for (size_t i = 0; i < _regs; ++i) c.reg(i) = f(a.reg(i), b.reg(i));
+    return c;
+}
+
+} // namespace detail
+
+//////////////////////
+// UNARY PLUS MINUS //
+//////////////////////
+template<class R, size_t _regs>
+inline const packed_interval<R, _regs>& operator+(
+    const packed_interval<R, _regs>& a) {
+    return a;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator-(
+    const packed_interval<R, _regs>& a) {
+    return detail::p_apply(a, detail::p_neg<R>);
+}
+
+///////////////////
+// OPERATOR PLUS //
+///////////////////
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator+(
+    const packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    return detail::p_apply(a, b, detail::p_add<R>);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator+(
+    const packed_interval<R, _regs>& a, double b) {
+    return a + packed_interval<R, _regs>(b);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator+(
+    double a, const packed_interval<R, _regs>& b) {
+    return b + a;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs>& operator+=(
+    packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    a = a + b;
+    return a;
+}
+
+////////////////////
+// OPERATOR MINUS //
+////////////////////
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator-(
+    const packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    return a + -b;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator-(
+    const packed_interval<R, _regs>& a, double b) {
+    return a + packed_interval<R, _regs>(-b);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator-(
+    double a, const packed_interval<R, _regs>& b) {
+    return -b + a;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs>& operator-=(
+    packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    a = a - b;
+    return a;
+}
+
+/////////////////////////////
+// OPERATOR MULTIPLICATION //
+/////////////////////////////
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator*(
+    const packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    return detail::p_apply(a, b, detail::p_mul<R>);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator*(
+    const packed_interval<R, _regs>& a, double b) {
+    using s = detail::simd<R>;
+    // Same scalar for all intervals, only a uniform branch on its sign
+    const packed_interval<R, _regs>& x = (b < 0) ? -a : a;
+    const R f = s::set1(std::fabs(b));
+    packed_interval<R, _regs> c;
+    for (size_t i = 0; i < _regs; ++i) c.reg(i) = s::mul(x.reg(i), f);
+    return c;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator*(
+    double a, const packed_interval<R, _regs>& b) {
+    return b * a;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs>& operator*=(
+    packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    a = a * b;
+    return a;
+}
+
+///////////////////////
+// OPERATOR DIVISION //
+///////////////////////
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator/(
+    const packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    return a * detail::p_apply(b, detail::p_recip<R>);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator/(
+    const packed_interval<R, _regs>& a, double b) {
+    using s = detail::simd<R>;
+    if (b == 0) {
+        return packed_interval<R, _regs>(interval(-INFINITY, INFINITY));
+    }
+    const packed_interval<R, _regs>& x = (b < 0) ? -a : a;
+    const R f = s::set1(std::fabs(b));
+    packed_interval<R, _regs> c;
+    for (size_t i = 0; i < _regs; ++i) c.reg(i) = s::div(x.reg(i), f);
+    return c;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> operator/(
+    double a, const packed_interval<R, _regs>& b) {
+    return a * detail::p_apply(b, detail::p_recip<R>);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs>& operator/=(
+    packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    a = a / b;
+    return a;
+}
+
+//////////////////
+// SQRT AND SQR //
+//////////////////
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> sqrt(const packed_interval<R, _regs>& a) {
+    return detail::p_apply(a, detail::p_sqrt<R>);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> sqr(const packed_interval<R, _regs>& a) {
+    return detail::p_apply(a, detail::p_sqr<R>);
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> abs(const packed_interval<R, _regs>& a) {
+    return detail::p_apply(a, detail::p_abs<R>);
+}
+
+////////////////
+// PROPERTIES //
+////////////////
+template<class R, size_t _regs>
+inline std::array<double, packed_interval<R, _regs>::size> mid(
+    const packed_interval<R, _regs>& a) {
+    interval r[packed_interval<R, _regs>::size];
+    a.store(r);
+    std::array<double, packed_interval<R, _regs>::size> m;
+    for (size_t k = 0; k < m.size(); ++k) {
+        m[k] = .5 * (r[k].lower() + r[k].upper());
+    }
+    return m;
+}
+
+template<class R, size_t _regs>
+inline std::array<double, packed_interval<R, _regs>::size> diam(
+    const packed_interval<R, _regs>& a) {
+    using s = detail::simd<R>;
+    interval r[packed_interval<R, _regs>::size];
+    // upper + -lower in the upper bound slot of every interval
+    for (size_t i = 0; i < _regs; ++i) {
+        s::store(r + i * s::width, s::add(a.reg(i), s::swap(a.reg(i))));
+    }
+    std::array<double, packed_interval<R, _regs>::size> d;
+    for (size_t k = 0; k < d.size(); ++k) {
+        d[k] = r[k].upper();
+    }
+    return d;
+}
+
+// Bit k is set if interval k contains zero
+template<class R, size_t _regs>
+inline int zero_in(const packed_interval<R, _regs>& a) {
+    using s = detail::simd<R>;
+    int mask = 0;
+    for (size_t i = 0; i < _regs; ++i) {
+        mask |= s::movemask_all(s::cmple(s::set1(0.0), a.reg(i))) <<
+            (i * s::width);
+    }
+    return mask;
+}
+
+template<class R, size_t _regs>
+inline packed_interval<R, _regs> intersect(
+    const packed_interval<R, _regs>& a, const packed_interval<R, _regs>& b) {
+    return detail::p_apply(a, b, detail::p_intersect<R>);
+}
+
+} // namespace rapidlab
+
+#endif
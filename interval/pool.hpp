@@ -0,0 +1,116 @@
+#ifndef RapidLab_pool_hpp
+#define RapidLab_pool_hpp
+
+#include "interval.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace rapidlab {
+namespace detail {
+
+// Storage for arrays of intervals whose length is set at run time. Arrays
+// released by a thread are kept in free lists of that thread, one for every
+// length, and handed out again by the next allocation of the same length.
+// A search allocates and releases boxes of one length all the time, so after
+// the first few boxes their storage no longer comes from the heap. Once the
+// lists of a thread are gone, as for boxes outliving its thread_locals,
+// arrays come from and go to the heap directly.
+class interval_pool {
+public:
+    static interval* allocate(size_t n) {
+        free_lists* lists = thread_lists();
+        std::vector<interval*>* list = lists ? lists->find(n) : nullptr;
+        if (list && !list->empty()) {
+            interval* p = list->back();
+            list->pop_back();
+            return p;
+        }
+        return new interval[n];
+    }
+
+    static void release(interval* p, size_t n) {
+        if (!p) {
+            return;
+        }
+        free_lists* lists = thread_lists();
+        if (!lists) {
+            delete[] p;
+            return;
+        }
+        std::vector<interval*>& list = lists->get(n);
+        if (list.size() < max_free) {
+            list.push_back(p);
+        } else {
+            delete[] p;
+        }
+    }
+
+private:
+    // Arrays kept per length and thread, beyond that they go to the heap
+    static const size_t max_free = 1 << 16;
+
+    struct free_lists {
+        // Lengths of the lists in lists, usually a single one
+        std::vector<size_t> lengths;
+        std::vector<std::vector<interval*>> lists;
+
+        free_lists() { current() = this; }
+
+        ~free_lists() {
+            current() = nullptr;
+            is_destroyed() = true;
+            for (std::vector<interval*>& list : lists) {
+                for (interval* p : list) {
+                    delete[] p;
+                }
+            }
+        }
+
+        std::vector<interval*>* find(size_t n) {
+            for (size_t k = 0; k < lengths.size(); ++k) {
+                if (lengths[k] == n) {
+                    return &lists[k];
+                }
+            }
+            return nullptr;
+        }
+
+        std::vector<interval*>& get(size_t n) {
+            std::vector<interval*>* list = find(n);
+            if (!list) {
+                lengths.push_back(n);
+                lists.emplace_back();
+                list = &lists.back();
+            }
+            return *list;
+        }
+    };
+
+    // Lists of this thread while they exist, and whether they have been
+    // destroyed. Neither has a destructor, so both stay valid until the
+    // thread ends and cost no guard on access.
+    static free_lists*& current() {
+        thread_local free_lists* lists = nullptr;
+        return lists;
+    }
+    static bool& is_destroyed() {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    // Lists of this thread, created on first use, null once destroyed
+    static free_lists* thread_lists() {
+        free_lists* lists = current();
+        if (lists || is_destroyed()) {
+            return lists;
+        }
+        thread_local free_lists cache;
+        return &cache;
+    }
+};
+
+} // namespace detail
+} // namespace rapidlab
+
+#endif
@@ -3,6 +3,8 @@
 
 #include "interval.hpp"
 
+#include <cmath>
+
 namespace rapidlab {
 
 inline double mid(const interval& a) {
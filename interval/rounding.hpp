@@ -0,0 +1,281 @@
+#ifndef RapidLab_rounding_hpp
+#define RapidLab_rounding_hpp
+
+#include <immintrin.h>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+namespace rapidlab {
+
+// Rounding policies of the interval operators. Intervals are stored as
+// (-lower, upper), so every bound is an upper bound and each policy only
+// supplies elementwise operations rounded toward +infinity.
+namespace rounding {
+
+// Relies on MXCSR rounding toward +infinity, set by the caller
+struct upward {
+    static const unsigned int mode = _MM_ROUND_UP;
+
+    static __m128d add(__m128d x, __m128d y) { return _mm_add_pd(x, y); }
+    static __m128d mul(__m128d x, __m128d y) { return _mm_mul_pd(x, y); }
+    static __m128d div(__m128d x, __m128d y) { return _mm_div_pd(x, y); }
+    static __m128d sqrt(__m128d x) { return _mm_sqrt_pd(x); }
+};
+
+// Computes under round to nearest. Error-free transformations give the
+// sign of each rounding error, results rounded down are moved to their
+// successor.
+struct nearest {
+    static const unsigned int mode = _MM_ROUND_NEAREST;
+
+    static __m128d add(__m128d x, __m128d y) {
+        // TwoSum
+        __m128d s = _mm_add_pd(x, y);
+        __m128d t = _mm_sub_pd(s, x);
+        __m128d e = _mm_add_pd(_mm_sub_pd(x, _mm_sub_pd(s, t)),
+                               _mm_sub_pd(y, t));
+        __m128d inexact = _mm_cmpnle_pd(e, _mm_setzero_pd());
+        if (near_limits(s)) {
+            return correct(s, inexact, _mm_and_pd(finite(x), finite(y)));
+        }
+        return round_up(s, inexact);
+    }
+
+    static __m128d mul(__m128d x, __m128d y) {
+        // TwoProd, the error is not representable for tiny products
+        __m128d p = _mm_mul_pd(x, y);
+        __m128d e = product_error(x, y, p);
+        __m128d zero = _mm_setzero_pd();
+        if (!near_limits(p)) return round_up(p, _mm_cmpnle_pd(e, zero));
+
+        __m128d tiny = _mm_and_pd(_mm_cmplt_pd(abs(p), _mm_set1_pd(0x1p-969)),
+            _mm_and_pd(_mm_cmpneq_pd(x, zero), _mm_cmpneq_pd(y, zero)));
+        tiny = _mm_andnot_pd(negative_zero(p, x, y), tiny);
+        return correct(p, _mm_or_pd(_mm_cmpnle_pd(e, zero), tiny),
+                       _mm_and_pd(finite(x), finite(y)));
+    }
+
+    static __m128d div(__m128d x, __m128d y) {
+        // Remainder x - q*y has the sign of the error times sign of y
+        __m128d q = _mm_div_pd(x, y);
+        __m128d r = residual(x, q, y);
+        __m128d sign = _mm_and_pd(y, _mm_set1_pd(-0.0));
+        __m128d zero = _mm_setzero_pd();
+        if (!near_limits(q) && !near_limits(x)) {
+            return round_up(q, _mm_cmpnle_pd(_mm_xor_pd(r, sign), zero));
+        }
+
+        __m128d bound = _mm_set1_pd(0x1p-969);
+        __m128d tiny = _mm_and_pd(_mm_or_pd(_mm_cmplt_pd(abs(q), bound),
+                                            _mm_cmplt_pd(abs(x), bound)),
+                                  _mm_cmpneq_pd(x, zero));
+        tiny = _mm_andnot_pd(negative_zero(q, x, y), tiny);
+        // Quotients by infinity are exact zeros
+        __m128d inexact = _mm_and_pd(finite(y), _mm_or_pd(
+            _mm_cmpnle_pd(_mm_xor_pd(r, sign), zero), tiny));
+        return correct(q, inexact,
+            _mm_and_pd(_mm_and_pd(finite(x), finite(y)), _mm_cmpneq_pd(y, zero)));
+    }
+
+    static __m128d sqrt(__m128d x) {
+        // Residual x - s*s is positive if s is below the root
+        __m128d s = _mm_sqrt_pd(x);
+        __m128d r = residual(x, s, s);
+        __m128d zero = _mm_setzero_pd();
+        if (!near_limits(x)) return round_up(s, _mm_cmpnle_pd(r, zero));
+
+        __m128d tiny = _mm_and_pd(_mm_cmplt_pd(x, _mm_set1_pd(0x1p-969)),
+                                  _mm_cmpneq_pd(x, zero));
+        return correct(s, _mm_or_pd(_mm_cmpnle_pd(r, zero), tiny), zero);
+    }
+
+private:
+    static __m128d abs(__m128d x) {
+        return _mm_andnot_pd(_mm_set1_pd(-0.0), x);
+    }
+
+    // Result r of operands x and y underflowed to zero from below, where
+    // zero already is the upward rounded result
+    static __m128d negative_zero(__m128d r, __m128d x, __m128d y) {
+        __m128d sign = _mm_and_pd(_mm_xor_pd(x, y), _mm_set1_pd(-0.0));
+        __m128d negative = _mm_cmplt_pd(_mm_or_pd(sign, _mm_set1_pd(1.0)),
+                                        _mm_setzero_pd());
+        return _mm_and_pd(negative, _mm_cmpeq_pd(r, _mm_setzero_pd()));
+    }
+
+    // Results close to underflow or overflowed to -infinity take the slow
+    // path, where error terms are not exact or the successor needs scaling
+    static bool near_limits(__m128d r) {
+        __m128d a = _mm_andnot_pd(_mm_set1_pd(-0.0), r);
+        return _mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(a, _mm_set1_pd(0x1p-969)),
+            _mm_cmpeq_pd(r, _mm_set1_pd(-INFINITY))));
+    }
+
+    // Successor where mask is set of r in the normal range, keeps nan and
+    // +infinity
+    static __m128d round_up(__m128d r, __m128d mask) {
+        const __m128d phi = _mm_set1_pd(0x1.0000000000001p-53);
+        __m128d succ = _mm_add_pd(r, _mm_mul_pd(phi, abs(r)));
+        return _mm_or_pd(_mm_and_pd(mask, succ), _mm_andnot_pd(mask, r));
+    }
+
+    static __m128d finite(__m128d x) {
+        return _mm_cmplt_pd(abs(x), _mm_set1_pd(INFINITY));
+    }
+
+    // Error terms overflow in Dekker's splitting, nan marks them unknown
+    static __m128d not_finite_to_nan(__m128d x) {
+        return _mm_or_pd(x, _mm_cmpnlt_pd(abs(x), _mm_set1_pd(INFINITY)));
+    }
+
+    // Error e = x*y - p, nan where it cannot be computed
+    static __m128d product_error(__m128d x, __m128d y, __m128d p) {
+#ifdef __FMA__
+        return _mm_fmsub_pd(x, y, p);
+#else
+        // Dekker's product with Veltkamp splitting
+        const __m128d factor = _mm_set1_pd(134217729.0);
+        __m128d c = _mm_mul_pd(factor, x);
+        __m128d xh = _mm_sub_pd(c, _mm_sub_pd(c, x));
+        __m128d xl = _mm_sub_pd(x, xh);
+        c = _mm_mul_pd(factor, y);
+        __m128d yh = _mm_sub_pd(c, _mm_sub_pd(c, y));
+        __m128d yl = _mm_sub_pd(y, yh);
+        __m128d e = _mm_sub_pd(_mm_mul_pd(xh, yh), p);
+        e = _mm_add_pd(e, _mm_mul_pd(xh, yl));
+        e = _mm_add_pd(e, _mm_mul_pd(xl, yh));
+        return not_finite_to_nan(_mm_add_pd(e, _mm_mul_pd(xl, yl)));
+#endif
+    }
+
+    // Residual x - q*y, exact if it does not underflow
+    static __m128d residual(__m128d x, __m128d q, __m128d y) {
+#ifdef __FMA__
+        return _mm_fnmadd_pd(q, y, x);
+#else
+        __m128d p = _mm_mul_pd(q, y);
+        return not_finite_to_nan(
+            _mm_sub_pd(_mm_sub_pd(x, p), product_error(q, y, p)));
+#endif
+    }
+
+    // Successor of finite r (Rump, Zimmermann, Boldo and Melquiond), the
+    // scaled middle range keeps it exact down to the subnormals
+    static __m128d successor(__m128d r) {
+        const __m128d phi = _mm_set1_pd(0x1.0000000000001p-53);
+        __m128d a = abs(r);
+        __m128d succ = _mm_add_pd(r, _mm_mul_pd(phi, a));
+        __m128d c = _mm_mul_pd(r, _mm_set1_pd(0x1p53));
+        __m128d scaled = _mm_mul_pd(_mm_add_pd(c, _mm_mul_pd(phi, abs(c))),
+                                    _mm_set1_pd(0x1p-53));
+        __m128d subnormal = _mm_add_pd(r, _mm_set1_pd(0x1p-1074));
+        __m128d small = _mm_cmplt_pd(a, _mm_set1_pd(0x1p-969));
+        __m128d tiny = _mm_cmplt_pd(a, _mm_set1_pd(0x1p-1021));
+        scaled = _mm_or_pd(_mm_and_pd(tiny, subnormal),
+                           _mm_andnot_pd(tiny, scaled));
+        return _mm_or_pd(_mm_and_pd(small, scaled), _mm_andnot_pd(small, succ));
+    }
+
+    // Successor of finite r where mask is set. Overflow of finite operands
+    // to -infinity rounds up to -DBL_MAX.
+    static __m128d correct(__m128d r, __m128d mask, __m128d finite_operands) {
+        __m128d succ = successor(r);
+        mask = _mm_and_pd(mask, finite(r));
+        r = _mm_or_pd(_mm_and_pd(mask, succ), _mm_andnot_pd(mask, r));
+        __m128d overflow = _mm_and_pd(finite_operands,
+            _mm_cmpeq_pd(r, _mm_set1_pd(-INFINITY)));
+        return _mm_or_pd(_mm_and_pd(overflow, _mm_set1_pd(-DBL_MAX)),
+                         _mm_andnot_pd(overflow, r));
+    }
+};
+
+} // namespace rounding
+
+// Policy of the interval operators, chosen at compile time
+#ifdef RAPIDLAB_ROUND_NEAREST
+using rounding_policy = rounding::nearest;
+#else
+using rounding_policy = rounding::upward;
+#endif
+
+// Sets the MXCSR rounding mode a policy needs on the calling thread and
+// restores the previous mode on destruction
+template<class policy = rounding_policy>
+class rounding_guard {
+private:
+    unsigned int csr;
+public:
+    rounding_guard() : csr(_mm_getcsr()) {
+        _mm_setcsr((csr & ~_MM_ROUND_MASK) | policy::mode);
+    }
+    ~rounding_guard() { _mm_setcsr(csr); }
+
+    rounding_guard(const rounding_guard&) = delete;
+    rounding_guard& operator=(const rounding_guard&) = delete;
+};
+
+// Floating point control state for worker threads, taken from the creating
+// thread with the rounding mode the policy needs. Threads of a pool start
+// in round to nearest, so parallel entry points install the context on
+// every worker before evaluating intervals.
+template<class policy = rounding_policy>
+class rounding_context {
+private:
+    unsigned int csr;
+public:
+    rounding_context()
+    : csr((_mm_getcsr() & ~_MM_ROUND_MASK) | policy::mode) {}
+
+    // Installs the context on the calling thread for its lifetime
+    class scope {
+    private:
+        unsigned int saved;
+    public:
+        explicit scope(const rounding_context& context) : saved(_mm_getcsr()) {
+            _mm_setcsr(context.csr);
+        }
+        ~scope() { _mm_setcsr(saved); }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+    };
+
+    // Task running f with the context installed, for thread pools
+    template<class F>
+    class task {
+    private:
+        rounding_context context;
+        F f;
+    public:
+        task(const rounding_context& context, F f)
+        : context(context), f(std::move(f)) {}
+
+        template<class... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(std::declval<const F&>()(std::forward<Args>(args)...)) {
+            scope installed(context);
+            return f(std::forward<Args>(args)...);
+        }
+    };
+
+    template<class F>
+    task<F> wrap(F f) const { return task<F>(*this, std::move(f)); }
+};
+
+namespace detail {
+
+// Debug check that the calling thread rounds as the policy needs
+template<class policy>
+inline void check_rounding() {
+    assert((_mm_getcsr() & _MM_ROUND_MASK) == policy::mode &&
+           "thread rounding mode does not match the rounding policy, "
+           "install a rounding_guard or rounding_context");
+}
+
+} // namespace detail
+
+} // namespace rapidlab
+
+#endif
@@ -0,0 +1,365 @@
+#ifndef RapidLab_tape_hpp
+#define RapidLab_tape_hpp
+
+#include "core.hpp"
+#include "box.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace rapidlab {
+
+class tape;
+
+namespace detail {
+
+enum class tape_op : uint32_t {
+    INPUT, CONST, ADD, SUB, MUL, DIV, NEG, SQR, SQRT, EXP, LOG, SIN, COS, ABS
+};
+
+// Operation with the indices of its arguments. Inputs and constants keep
+// the index of the input or constant in a.
+struct tape_node {
+    tape_op op;
+    uint32_t a;
+    uint32_t b;
+};
+
+} // namespace detail
+
+// Value of an objective recorded on a tape, or a constant not recorded yet
+class tape_var {
+private:
+    tape* t = nullptr;
+    uint32_t i = 0;
+    interval c;
+
+public:
+    tape_var() : c(0) {}
+    tape_var(double a) : c(a) {}
+    tape_var(const interval& a) : c(a) {}
+    tape_var(tape* t, uint32_t i) : t(t), i(i), c(0) {}
+
+    tape* recording() const { return t; }
+    uint32_t index() const { return i; }
+    const interval& constant() const { return c; }
+};
+
+// Operation sequence of an objective, recorded once and replayed on every
+// box. Nodes live in one contiguous arena and refer to their arguments by
+// index, so recording allocates only when the arena grows. The recorded
+// sequence must not depend on the values, e.g. through branches.
+class tape {
+private:
+    std::vector<detail::tape_node> nodes;
+    std::vector<interval> constants;
+    uint32_t inputs = 0;
+    uint32_t output = 0;
+
+public:
+    tape() { nodes.reserve(1024); }
+    tape(const tape&) = default;
+    tape& operator=(const tape&) = default;
+
+    // Records f called with _size independent variables
+    template<size_t _size, class F>
+    static tape record(const F& f) {
+        tape t;
+        std::array<tape_var, _size> x;
+        for (size_t k = 0; k < _size; ++k) {
+            x[k] = tape_var(&t, t.push(detail::tape_op::INPUT, t.inputs++, 0));
+        }
+        t.output = t.index_of(f(x));
+        return t;
+    }
+
+    size_t size() const { return nodes.size(); }
+    size_t input_count() const { return inputs; }
+
+    // Node of v on this tape, recording constants on first use
+    uint32_t index_of(const tape_var& v) {
+        if (v.recording() == this) return v.index();
+        constants.push_back(v.constant());
+        return push(detail::tape_op::CONST, constants.size() - 1, 0);
+    }
+
+    uint32_t push(detail::tape_op op, uint32_t a, uint32_t b) {
+        nodes.push_back(detail::tape_node{op, a, b});
+        return nodes.size() - 1;
+    }
+
+    class sweep;
+};
+
+// Work space replaying a tape: values, and for derivatives the tangents,
+// adjoints and adjoint tangents of every node. Buffers are kept across
+// boxes and only grow.
+class tape::sweep {
+private:
+    const tape* t = nullptr;
+    std::vector<interval> v, dv, w, dw;
+
+    // First and second derivative of the unary operation of node i
+    void partials(const detail::tape_node& n, size_t i,
+                  interval& d1, interval& d2) const {
+        using detail::tape_op;
+        const interval& a = v[n.a];
+        switch (n.op) {
+        case tape_op::NEG:  d1 = interval(-1); d2 = interval(0); break;
+        case tape_op::SQR:  d1 = 2 * a; d2 = interval(2); break;
+        case tape_op::SQRT: d1 = 0.5 / v[i]; d2 = -0.25 / (v[i] * a); break;
+        case tape_op::EXP:  d1 = v[i]; d2 = v[i]; break;
+        case tape_op::LOG:  d1 = 1.0 / a; d2 = -sqr(d1); break;
+        case tape_op::SIN:  d1 = cos(a); d2 = -v[i]; break;
+        case tape_op::COS:  d1 = -sin(a); d2 = -v[i]; break;
+        default:
+            //abs has no second derivative where its argument contains zero
+            d1 = interval(-1, 1);
+            d2 = interval(-INFINITY, INFINITY);
+            if (a.lower() > 0) {
+                d1 = interval(1);
+                d2 = interval(0);
+            } else if (a.upper() < 0) {
+                d1 = interval(-1);
+                d2 = interval(0);
+            }
+        }
+    }
+
+    // Adjoint sweep, with the tangents of the adjoints if second is set
+    void reverse(bool second) {
+        using detail::tape_op;
+        const size_t n = t->nodes.size();
+        std::fill(w.begin(), w.begin() + n, interval(0));
+        w[t->output] = interval(1);
+        if (second) std::fill(dw.begin(), dw.begin() + n, interval(0));
+
+        for (size_t i = n; i-- > 0;) {
+            const detail::tape_node& node = t->nodes[i];
+            const interval wi = w[i];
+            switch (node.op) {
+            case tape_op::INPUT:
+            case tape_op::CONST:
+                break;
+            case tape_op::ADD:
+                w[node.a] += wi;
+                w[node.b] += wi;
+                if (second) {
+                    dw[node.a] += dw[i];
+                    dw[node.b] += dw[i];
+                }
+                break;
+            case tape_op::SUB:
+                w[node.a] += wi;
+                w[node.b] -= wi;
+                if (second) {
+                    dw[node.a] += dw[i];
+                    dw[node.b] -= dw[i];
+                }
+                break;
+            case tape_op::MUL:
+                w[node.a] += wi * v[node.b];
+                w[node.b] += wi * v[node.a];
+                if (second) {
+                    dw[node.a] += dw[i] * v[node.b] + wi * dv[node.b];
+                    dw[node.b] += dw[i] * v[node.a] + wi * dv[node.a];
+                }
+                break;
+            case tape_op::DIV: {
+                const interval r = 1.0 / v[node.b];
+                w[node.a] += wi * r;
+                w[node.b] -= wi * v[i] * r;
+                if (second) {
+                    const interval r2 = sqr(r);
+                    dw[node.a] += dw[i] * r - wi * dv[node.b] * r2;
+                    dw[node.b] += wi * r2 * (2 * v[i] * dv[node.b] - dv[node.a])
+                                - dw[i] * v[i] * r;
+                }
+                break;
+            }
+            default: {
+                interval d1, d2;
+                partials(node, i, d1, d2);
+                w[node.a] += wi * d1;
+                if (second) {
+                    dw[node.a] += dw[i] * d1;
+                    //abs at its kink has an unbounded d2, a zero tangent
+                    //makes the term zero rather than nan
+                    if (dv[node.a] != interval(0)) {
+                        dw[node.a] += wi * d2 * dv[node.a];
+                    }
+                }
+            }
+            }
+        }
+    }
+
+public:
+    // Evaluates every node over x, returns the bounds of the objective
+    interval forward(const tape& recorded, const interval* x) {
+        using detail::tape_op;
+        t = &recorded;
+        const size_t n = t->nodes.size();
+        if (v.size() < n) {
+            v.resize(n);
+            dv.resize(n);
+            w.resize(n);
+            dw.resize(n);
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const detail::tape_node& node = t->nodes[i];
+            switch (node.op) {
+            case tape_op::INPUT: v[i] = x[node.a]; break;
+            case tape_op::CONST: v[i] = t->constants[node.a]; break;
+            case tape_op::ADD:   v[i] = v[node.a] + v[node.b]; break;
+            case tape_op::SUB:   v[i] = v[node.a] - v[node.b]; break;
+            case tape_op::MUL:   v[i] = v[node.a] * v[node.b]; break;
+            case tape_op::DIV:   v[i] = v[node.a] / v[node.b]; break;
+            case tape_op::NEG:   v[i] = -v[node.a]; break;
+            case tape_op::SQR:   v[i] = sqr(v[node.a]); break;
+            case tape_op::SQRT:  v[i] = sqrt(v[node.a]); break;
+            case tape_op::EXP:   v[i] = exp(v[node.a]); break;
+            case tape_op::LOG:   v[i] = log(v[node.a]); break;
+            case tape_op::SIN:   v[i] = sin(v[node.a]); break;
+            case tape_op::COS:   v[i] = cos(v[node.a]); break;
+            case tape_op::ABS:   v[i] = abs(v[node.a]); break;
+            }
+        }
+        return v[t->output];
+    }
+
+    template<size_t _size>
+    interval forward(const tape& recorded, const box<_size>& b) {
+        return forward(recorded, b.coordinates().data());
+    }
+
+    // Bounds of the gradient over the inputs of the last forward sweep
+    void gradient(interval* g) {
+        reverse(false);
+        collect(w, g);
+    }
+
+    // Column j of the Hessian bounds over the same inputs, by a tangent
+    // sweep along input j followed by the adjoint sweep
+    void hessian_column(size_t j, interval* h) {
+        using detail::tape_op;
+        const size_t n = t->nodes.size();
+        for (size_t i = 0; i < n; ++i) {
+            const detail::tape_node& node = t->nodes[i];
+            switch (node.op) {
+            case tape_op::INPUT: dv[i] = interval(node.a == j ? 1 : 0); break;
+            case tape_op::CONST: dv[i] = interval(0); break;
+            case tape_op::ADD:   dv[i] = dv[node.a] + dv[node.b]; break;
+            case tape_op::SUB:   dv[i] = dv[node.a] - dv[node.b]; break;
+            case tape_op::MUL:
+                dv[i] = dv[node.a] * v[node.b] + v[node.a] * dv[node.b];
+                break;
+            case tape_op::DIV:
+                dv[i] = (dv[node.a] - v[i] * dv[node.b]) / v[node.b];
+                break;
+            default: {
+                interval d1, d2;
+                partials(node, i, d1, d2);
+                dv[i] = d1 * dv[node.a];
+            }
+            }
+        }
+        reverse(true);
+        collect(dw, h);
+    }
+
+private:
+    void collect(const std::vector<interval>& x, interval* r) const {
+        const size_t n = t->nodes.size();
+        for (size_t i = 0; i < n; ++i) {
+            if (t->nodes[i].op == detail::tape_op::INPUT) {
+                r[t->nodes[i].a] = x[i];
+            }
+        }
+    }
+};
+
+namespace detail {
+
+template<class V>
+using if_tape_var = typename std::enable_if<
+    std::is_same<V, tape_var>::value, tape_var>::type;
+
+inline tape_var record(tape_op op, const tape_var& a, const tape_var& b) {
+    tape* t = a.recording() ? a.recording() : b.recording();
+    return tape_var(t, t->push(op, t->index_of(a), t->index_of(b)));
+}
+
+inline tape_var record(tape_op op, const tape_var& a) {
+    tape* t = a.recording();
+    return tape_var(t, t->push(op, a.index(), 0));
+}
+
+} // namespace detail
+
+// Operations on tape variables record a node, operations on constants only
+// evaluate. Templates keep doubles from converting to tape_var.
+#define RAPIDLAB_TAPE_BINARY(OP, CODE)                                     \
+template<class V>                                                          \
+inline detail::if_tape_var<V> operator OP(const V& a, const V& b) {        \
+    if (!a.recording() && !b.recording()) {                                \
+        return tape_var(a.constant() OP b.constant());                     \
+    }                                                                      \
+    return detail::record(detail::tape_op::CODE, a, b);                    \
+}                                                                          \
+template<class V>                                                          \
+inline detail::if_tape_var<V> operator OP(const V& a, const interval& b) { \
+    return a OP tape_var(b);                                               \
+}                                                                          \
+template<class V>                                                          \
+inline detail::if_tape_var<V> operator OP(const interval& a, const V& b) { \
+    return tape_var(a) OP b;                                               \
+}                                                                          \
+template<class V>                                                          \
+inline detail::if_tape_var<V>& operator OP##=(V& a, const V& b) {          \
+    a = a OP b;                                                            \
+    return a;                                                              \
+}                                                                          \
+template<class V>                                                          \
+inline detail::if_tape_var<V>& operator OP##=(V& a, const interval& b) {   \
+    a = a OP tape_var(b);                                                  \
+    return a;                                                              \
+}
+
+RAPIDLAB_TAPE_BINARY(+, ADD)
+RAPIDLAB_TAPE_BINARY(-, SUB)
+RAPIDLAB_TAPE_BINARY(*, MUL)
+RAPIDLAB_TAPE_BINARY(/, DIV)
+
+#undef RAPIDLAB_TAPE_BINARY
+
+#define RAPIDLAB_TAPE_UNARY(FUNC, CODE)                                    \
+template<class V>                                                          \
+inline detail::if_tape_var<V> FUNC(const V& a) {                           \
+    if (!a.recording()) return tape_var(FUNC(a.constant()));               \
+    return detail::record(detail::tape_op::CODE, a);                       \
+}
+
+RAPIDLAB_TAPE_UNARY(operator-, NEG)
+RAPIDLAB_TAPE_UNARY(sqr, SQR)
+RAPIDLAB_TAPE_UNARY(sqrt, SQRT)
+RAPIDLAB_TAPE_UNARY(exp, EXP)
+RAPIDLAB_TAPE_UNARY(log, LOG)
+RAPIDLAB_TAPE_UNARY(sin, SIN)
+RAPIDLAB_TAPE_UNARY(cos, COS)
+RAPIDLAB_TAPE_UNARY(abs, ABS)
+
+#undef RAPIDLAB_TAPE_UNARY
+
+template<class V>
+inline const detail::if_tape_var<V>& operator+(const V& a) {
+    return a;
+}
+
+} // namespace rapidlab
+
+#endif
@@ -3,68 +3,292 @@
 
 #include <algorithm>
 
-template <size_t _size_p>
-box<_size_p> optimizer<_size_p>::solve(const box<_size_p>& box0) {
-    using namespace std::chrono;
-    auto start_time = high_resolution_clock::now();
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+box<_size_p> optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::solve(const box<_size_p>& box0) {
+    this->start_time = std::chrono::high_resolution_clock::now();
+
+    //round as the interval operators need, whatever the caller set
+    rounding_context<>::scope rounding((rounding_context<>()));
 
+    this->box0 = box0;
     this->num_boxes = 0;
+    this->f_min = INFINITY;
+    this->f_closed = INFINITY;
+    this->stopped = stop_reason::COMPLETE;
+
+    unsigned num_threads = this->options.threads;
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    //threads share their open boxes, which none of these can store
+    const options_t& o = this->options;
+    if (num_threads > 1 && (o.compact_boxes || o.max_memory_boxes > 0 ||
+                            !o.checkpoint_file.empty())) {
+        throw std::invalid_argument("compact_boxes, max_memory_boxes and "
+                                    "checkpoint_file need threads = 1");
+    }
+    //built in place, a copied worker would copy uninitialized workspaces
+    std::vector<worker> workers;
+    workers.reserve(num_threads);
+    for (unsigned i = 0; i < num_threads; ++i) {
+        workers.emplace_back(box0.size());
+    }
+    seed_incumbent(box0, workers);
 
-    //initialize lists
-    std::vector<box<_size_p>> list;
-    list.push_back(box0);
+    box<_size_p> root(box0);
+    root.set_rank(-INFINITY);
 
-    //current box from list
-    box<_size_p> b;
-    //solution box
-    box<_size_p> solution;
+    if (num_threads > 1) {
+        solve_parallel(root, workers);
+    } else if (this->options.compact_boxes) {
+        compact_open_list<_size_p> list(this->options, this->f_min);
+        list.push(root);
+        search(list, workers[0]);
+    } else if (this->options.max_memory_boxes > 0) {
+        spilling_open_list<_size_p> list(this->options, this->f_min);
+        list.push(root);
+        search(list, workers[0]);
+    } else {
+        //initialize lists
+        open_list<_size_p> list(this->options, this->f_min);
+        list.push(root);
+        search(list, workers[0]);
+    }
 
-    while (list.size() > 0) {
-        //pop box from list
-        b = list.back();
-        list.pop_back();
+    return collect(workers);
+}
 
-        //decrease box size or reject
-        const bool is_rejected = check_box(b);
-        if (is_rejected) {
-            continue;
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+box<_size_p> optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::collect(
+    std::vector<worker>& workers) {
+    using namespace std::chrono;
+
+    //collect results of all workers
+    box<_size_p> solution = workers[0].solution;
+    double f_solution = workers[0].f_solution;
+    this->stats = solve_statistics();
+    for (const worker& w : workers) {
+        this->num_boxes += w.num_boxes;
+        this->stats.merge(w.stats);
+        if (w.f_solution < f_solution) {
+            solution = w.solution;
+            f_solution = w.f_solution;
         }
+    }
 
-        auto within_tolerance = [&](const interval& ival) {
-            return diam(ival) <= this->options.epsilon;
-        };
-        const bool is_within_tolerance =
-            std::all_of(b.begin(), b.end(), within_tolerance);
+    auto end_time = high_resolution_clock::now();
+    this->calc_time = duration_cast<microseconds>(
+        end_time - this->start_time).count() / 1e6;
 
-        //scalar result at interval mid point
-        std::array<double, _size_p> m = mid<_size_p>(b);
-        interval f_center = this->func(m);
+    return solution;
+}
 
-        if (is_within_tolerance) {
-            if (this->f_min >= f_center.upper()) {
-                solution = m;
-                this->f_min = f_center.upper();
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class list_t>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::search(
+    list_t& list, worker& w) {
+    //boxes of this worker after which the list is saved
+    const int64_t checkpoint_boxes = this->options.checkpoint_file.empty() ?
+        0 : this->options.checkpoint_boxes;
+    int64_t next_checkpoint = checkpoint_boxes > 0 ?
+        w.num_boxes + checkpoint_boxes : INT64_MAX;
+    //and after which progress is reported
+    const int64_t progress_boxes = this->func_progress ?
+        this->options.progress_boxes : 0;
+    int64_t next_progress = progress_boxes > 0 ?
+        w.num_boxes + progress_boxes : INT64_MAX;
+
+    //blocks of boxes from list, or the current box
+    std::vector<box<_size_p>> boxes;
+    box<_size_p> b(w.center);
+
+    while (!list.empty()) {
+        if (this->func_batch) {
+            //pop as many boxes as fit into a block
+            boxes.clear();
+            while (!list.empty() &&
+                   boxes.size() < box_block<_size_p>::capacity) {
+                boxes.push_back(list.pop());
             }
+
+            process_block(boxes, w, list);
         } else {
-            //update minimum bound
-            if (this->f_min > f_center.upper()) {
-                solution = m;
-                this->f_min = f_center.upper();
+            //pop box from list
+            b = list.pop();
+
+            process_box(b, w, list);
+        }
+
+        if (this->options.collect_statistics) {
+            w.stats.peak_open_boxes =
+                std::max(w.stats.peak_open_boxes, list.size());
+        }
+        if (w.num_boxes >= next_checkpoint) {
+            save_checkpoint(list, w);
+            next_checkpoint = w.num_boxes + checkpoint_boxes;
+        }
+        if (w.num_boxes >= next_progress) {
+            next_progress = w.num_boxes + progress_boxes;
+            if (!report_progress(this->num_boxes + w.num_boxes,
+                                 list.size(), list.min_rank())) {
+                this->stopped = stop_reason::PROGRESS;
+                break;
             }
-            //bisect current box
-            std::array<box<_size_p>, 2> bisected_boxes;
-            bisected_boxes = bisection(b);
-            //add boxes to list
-            list.emplace_back(bisected_boxes[0]);
-            list.emplace_back(bisected_boxes[1]);
+        }
+        this->stopped = limit_reached(
+            this->num_boxes + w.num_boxes, list.size(), w.center.size());
+        if (this->stopped != stop_reason::COMPLETE) {
+            break;
         }
     }
 
-    auto end_time = high_resolution_clock::now();
-    this->calc_time = duration_cast<microseconds>(
-        end_time - start_time).count() / 1e6;
+    this->num_open = list.size();
+    this->f_open = list.min_rank();
+}
 
-    return solution;
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+stop_reason optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::limit_reached(
+    int64_t boxes, size_t open, size_t n) const {
+    const options_t& o = this->options;
+    if (o.max_boxes > 0 && boxes >= o.max_boxes) {
+        return stop_reason::BOXES;
+    }
+    //open boxes with the coordinates of dynamic ones
+    const size_t box_bytes = sizeof(box<_size_p>) +
+        (_size_p == dynamic ? n * sizeof(interval) : 0);
+    if (o.max_memory > 0 && open * box_bytes > o.max_memory) {
+        return stop_reason::MEMORY;
+    }
+    if (o.max_time > 0) {
+        const std::chrono::duration<double> since =
+            std::chrono::high_resolution_clock::now() - this->start_time;
+        if (since.count() >= o.max_time) {
+            return stop_reason::TIME;
+        }
+    }
+    return stop_reason::COMPLETE;
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+bool optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::report_progress(
+    int64_t boxes, size_t open, double f_open_boxes) const {
+    solve_progress p;
+    p.boxes = boxes;
+    p.open_boxes = open;
+    const std::chrono::duration<double> since =
+        std::chrono::high_resolution_clock::now() - this->start_time;
+    p.time = since.count();
+    p.minimum = this->f_min.load(std::memory_order_relaxed);
+    p.lower_bound = bound(f_open_boxes);
+    p.gap = p.minimum - p.lower_bound;
+    return this->func_progress(p);
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+double optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::bound(
+    double f_open_boxes) const {
+    //the minimum is in an open box, a box closed within tolerance, or
+    //at the incumbent
+    return std::min(std::min(f_open_boxes,
+                             this->f_closed.load(std::memory_order_relaxed)),
+                    this->f_min.load(std::memory_order_relaxed));
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class list_t>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::process_box(
+    box<_size_p>& b, worker& w, list_t& children) {
+    ++w.num_boxes;
+
+    //decrease box size or reject
+    const bool is_rejected = check_box(b, w);
+    if (is_rejected) {
+        return;
+    }
+
+    auto within_tolerance = [&](const interval& ival) {
+        return diam(ival) <= this->options.epsilon;
+    };
+    const bool is_within_tolerance =
+        std::all_of(b.begin(), b.end(), within_tolerance);
+
+    //scalar result at interval mid point
+    const box<_size_p>& m = w.center;
+    mid(b, w.center);
+    interval f_center;
+    {
+        detail::scoped_timer timer(timed(w.stats.func_time));
+        f_center = this->func(m);
+    }
+
+    if (is_within_tolerance) {
+        ++w.stats.tolerance;
+        close_box(b);
+        update_minimum(w, m, f_center.upper(), true);
+    } else {
+        //update minimum bound
+        const bool is_improved = update_minimum(w, m, f_center.upper(), false);
+        if (wants_local_search(w, is_improved)) {
+            local_search(b, w);
+        }
+        //bisect current box and add boxes to list, which takes its storage
+        ++w.stats.bisected;
+        {
+            detail::scoped_timer timer(timed(w.stats.bisection_time));
+            bisection(b, w.gradient, children);
+        }
+    }
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::close_box(
+    const box<_size_p>& b) {
+    double current = this->f_closed.load(std::memory_order_relaxed);
+    while (b.get_rank() < current && !this->f_closed.compare_exchange_weak(
+            current, b.get_rank(), std::memory_order_relaxed)) {}
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+bool optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::update_minimum(
+    worker& w, const box<_size_p>& m, double f, bool accept_equal) {
+    double current = this->f_min.load(std::memory_order_relaxed);
+    bool is_lower = f < current;
+    if (!(is_lower || (accept_equal && f == current))) {
+        return false;
+    }
+    //constraints only once the point would count
+    const box<_size_p>* point = &m;
+    if (!this->equalities.empty()) {
+        //no point is exactly feasible, bound the function over a box
+        //holding one instead
+        if (!verify_feasible_box(m, w)) {
+            return false;
+        }
+        point = &w.equality.feasible;
+        {
+            detail::scoped_timer timer(timed(w.stats.func_time));
+            f = this->func(*point).upper();
+        }
+        is_lower = f < current;
+        if (!(is_lower || (accept_equal && f == current))) {
+            return false;
+        }
+    }
+    if (!this->constraints.empty() && !is_feasible_point(*point, w)) {
+        return false;
+    }
+    w.solution = *point;
+    w.f_solution = f;
+    if (this->options.collect_statistics && is_lower) {
+        const std::chrono::duration<double> since =
+            std::chrono::high_resolution_clock::now() - this->start_time;
+        w.stats.incumbents.push_back(solve_statistics::incumbent{
+            since.count(), this->num_boxes + w.num_boxes, f});
+    }
+    //lower shared minimum unless another thread found a better one
+    while (f < current && !this->f_min.compare_exchange_weak(
+            current, f, std::memory_order_relaxed)) {}
+    return is_lower;
 }
 
 #endif
@@ -0,0 +1,114 @@
+#ifndef RapidLab_opt_batch_hpp
+#define RapidLab_opt_batch_hpp
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class list_t>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::process_block(
+    std::vector<box<_size_p>>& boxes, worker& w, list_t& children) {
+    assert(boxes.size() <= box_block<_size_p>::capacity);
+
+    //derivative tests box by box, keeping the remaining boxes in front
+    size_t count = 0;
+    for (size_t k = 0; k < boxes.size(); ++k) {
+        ++w.num_boxes;
+        const feasibility feasible = check_constraints(boxes[k], w);
+        if (feasible == feasibility::INFEASIBLE) {
+            ++w.stats.infeasible;
+            continue;
+        }
+        if (!check_derivatives(boxes[k], w.gradients[count], w, 0,
+                               feasible == feasibility::FEASIBLE)) {
+            if (count != k) {
+                boxes[count] = boxes[k];
+            }
+            ++count;
+        }
+    }
+    if (count == 0) {
+        return;
+    }
+
+    //bound function over all remaining boxes in one call
+    w.block.clear();
+    for (size_t k = 0; k < count; ++k) {
+        w.block.push_back(boxes[k]);
+    }
+    w.block.pad();
+    {
+        detail::scoped_timer timer(timed(w.stats.func_time));
+        this->func_batch(w.block, w.bounds.data());
+    }
+
+    //reject boxes above the current minimum
+    const double f_min_block = this->f_min.load(std::memory_order_relaxed);
+    size_t remaining = 0;
+    for (size_t k = 0; k < count; ++k) {
+        if (w.bounds[k].lower() > f_min_block) {
+            ++w.stats.cutoff;
+            continue;
+        }
+        //rank box by its lower bound for best-first search
+        boxes[k].set_rank(w.bounds[k].lower());
+        if (remaining != k) {
+            boxes[remaining] = boxes[k];
+            if (has_gradient()) {
+                w.gradients[remaining] = w.gradients[k];
+            }
+        }
+        ++remaining;
+    }
+    if (remaining == 0) {
+        return;
+    }
+
+    //scalar results at interval mid points in one call
+    w.block.clear();
+    for (size_t k = 0; k < remaining; ++k) {
+        mid(boxes[k], w.center);
+        w.block.push_back(w.center);
+    }
+    w.block.pad();
+    {
+        detail::scoped_timer timer(timed(w.stats.func_time));
+        this->func_batch(w.block, w.bounds.data());
+    }
+
+    for (size_t k = 0; k < remaining; ++k) {
+        box<_size_p>& b = boxes[k];
+        const bool is_within_tolerance = std::all_of(b.begin(), b.end(),
+            [&](const interval& ival) {
+                return diam(ival) <= this->options.epsilon;
+            });
+
+        //mid point again only if it may become the minimum
+        const box<_size_p>& m = w.center;
+        const double f_center = w.bounds[k].upper();
+        const bool is_candidate =
+            f_center <= this->f_min.load(std::memory_order_relaxed);
+        if (is_candidate) {
+            mid(b, w.center);
+        }
+        if (is_within_tolerance) {
+            ++w.stats.tolerance;
+            close_box(b);
+            if (is_candidate) {
+                update_minimum(w, m, f_center, true);
+            }
+        } else {
+            //update minimum bound
+            const bool is_improved = is_candidate &&
+                update_minimum(w, m, f_center, false);
+            if (wants_local_search(w, is_improved)) {
+                local_search(b, w);
+            }
+            //bisect current box and add boxes to list, which takes its storage
+            ++w.stats.bisected;
+            {
+                detail::scoped_timer timer(timed(w.stats.bisection_time));
+                bisection(b, w.gradients[k], children);
+            }
+        }
+    }
+}
+
+#endif
@@ -1,25 +1,66 @@
 #ifndef RapidLab_opt_bisection_hpp
 #define RapidLab_opt_bisection_hpp
 
-template <size_t _size_p>
-std::array<box<_size_p>, 2>
-optimizer<_size_p>::bisection(const box<_size_p>& b) const {
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+size_t optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::split_coordinate(
+    const box<_size_p>& b, const vector_t& f_d) const {
 
-    size_t split_element = 0;
-    std::array<double, _size_p> w = diam(b);
+    if (this->options.bi_mode == bisection_mode::ROUND_ROBIN) {
+        return b.get_depth() % b.size();
+    }
+
+    //first coordinate of largest weight
+    size_t widest = 0;
+    size_t split = 0;
+    double max_diam = -1;
+    double max_weight = -1;
+    for (size_t i = 0; i < b.size(); ++i) {
+        const double w_i = diam(b[i]);
+        double weight = w_i;
+        switch (this->options.bi_mode) {
+        case bisection_mode::MAX_SMEAR_DIAM:
+            if (has_gradient()) {
+                //weigh width by the magnitude of the gradient
+                weight = mag(f_d[i]) * w_i;
+                weight = std::isnan(weight) ? 0 : weight;
+            }
+            break;
+        case bisection_mode::MAX_RELATIVE_DIAM:
+            weight /= std::max(1.0, mag(b[i]));
+            break;
+        case bisection_mode::ROUND_ROBIN:
+        case bisection_mode::MAX_DIAM:
+            break;
+        }
+        if (w_i > max_diam) {
+            max_diam = w_i;
+            widest = i;
+        }
+        if (weight > max_weight) {
+            max_weight = weight;
+            split = i;
+        }
+    }
 
-    if (this->options.bi_mode == bisection_mode::MAX_DIAM) {
-        split_element = std::distance(
-            w.begin(), std::max_element(w.begin(), w.end()));
+    if (max_weight == 0 && this->options.bi_mode ==
+        bisection_mode::MAX_SMEAR_DIAM) {
+        //function is flat over box, fall back to widest coordinate
+        return widest;
     }
+    return split;
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class list_t>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::bisection(
+    box<_size_p>& b, const vector_t& f_d, list_t& list) const {
 
-    std::array<box<_size_p>, 2> q = {b,b};
-    //Bisect box interval at split_element
-    double m = mid(b[split_element]);
-    (q[0])[split_element].set_upper(m);
-    (q[1])[split_element].set_lower(m);
+    const size_t split_element = split_coordinate(b, f_d);
+    const size_t sections = std::max<size_t>(2, this->options.sections);
 
-    return q;
+    //split box interval at split_element into equally wide sections,
+    //the last one in the storage of b
+    detail::push_sections(list, std::move(b), split_element, sections);
 }
 
 #endif
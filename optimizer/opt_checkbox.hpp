@@ -1,53 +1,165 @@
 #ifndef RapidLab_opt_checkbox_hpp
 #define RapidLab_opt_checkbox_hpp
 
-template <size_t _size_p>
-int optimizer<_size_p>::check_box(box<_size_p>& b) {
-    ++this->num_boxes;
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::evaluate(
+    const box<_size_p>& b, unsigned flags, worker& w) {
+    evaluation<_size_p>& e = w.eval;
+    //orders of the combined callback in one pass
+    const unsigned combined = flags & this->eval_provides;
+    if (combined) {
+        solve_statistics& s = w.stats;
+        detail::scoped_timer timer(timed(
+            (combined & EVALUATE_HESSIAN) ? s.func_dd_time :
+            (combined & EVALUATE_GRADIENT) ? s.func_d_time : s.func_time));
+        func_eval(b, combined, e);
+    }
+    //remaining orders from the separate callbacks
+    flags &= ~combined;
+    if (flags & EVALUATE_GRADIENT) {
+        detail::scoped_timer timer(timed(w.stats.func_d_time));
+        e.gradient = func_d(b);
+    }
+    if (flags & EVALUATE_HESSIAN) {
+        detail::scoped_timer timer(timed(w.stats.func_dd_time));
+        e.hessian = func_dd(b);
+    }
+    if (flags & EVALUATE_VALUE) {
+        detail::scoped_timer timer(timed(w.stats.func_time));
+        e.value = func(b);
+    }
+}
 
-    if (this->func_d) {
-        std::array<interval, _size_p> f_d = func_d(b);
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+int optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::check_derivatives(
+    box<_size_p>& b, vector_t& f_d, worker& w, unsigned flags,
+    bool is_feasible) {
+    evaluation<_size_p>& e = w.eval;
+    //a constrained minimum may lie where the gradient is nonzero, boxes
+    //not certainly feasible take the Fritz John test instead
+    const bool gradient = has_gradient();
+    const bool hessian = has_hessian() && is_feasible;
+    if (gradient) {
+        flags |= EVALUATE_GRADIENT;
+    }
+    if (hessian) {
+        flags |= EVALUATE_HESSIAN;
+    }
+    if (flags == 0) {
+        return 0;
+    }
+    evaluate(b, flags, w);
 
+    if (gradient) {
+        f_d = e.gradient;
+        if (!is_feasible && fritz_john(b, f_d, w)) {
+            ++w.stats.fritz_john_empty;
+            return 1;
+        }
         //MONOTONY TEST
-        for (size_t i = 0; i < _size_p; i++) {
+        for (size_t i = 0; i < b.size() && is_feasible; i++) {
             if (f_d[i].upper() < 0 || f_d[i].lower() > 0) {
                 //derivation over box is monotone -> no local minimum possible
+                ++w.stats.monotonicity;
                 return 1;
             }
         }
     }
 
-    if (this->func_dd) {
+    if (hessian) {
         //NONCONVEXITY TEST
-        Eigen::Matrix<interval, _size_p, _size_p> f_dd = func_dd(b);
-        for (size_t i = 0; i < _size_p; i++) {
+        const matrix_t& f_dd = e.hessian;
+        for (size_t i = 0; i < b.size(); i++) {
             if (f_dd(i,i).upper() < 0) {
                 //Function is non-convex over box
+                ++w.stats.nonconvexity;
                 return 1;
             }
         }
 
         //GAUSS-SEIDEL
-        std::array<double, _size_p> c; //(mid<_size_p>(b));
-        for (size_t i = 0; i < _size_p; ++i) {
-            c[i] = mid(b[i]);
+        mid(b, w.center);
+        for (size_t i = 0; i < b.size(); ++i) {
+            w.gs.x_tilda[i] = w.center[i].lower();
+        }
+        //gradient only, keeps the Hessian in e
+        evaluate(w.center, EVALUATE_GRADIENT, w);
+        for (size_t i = 0; i < b.size(); ++i) {
+            w.gs.rhs(i) = -mid(e.gradient[i]);
         }
-        std::array<interval, _size_p> fd_c = func_d(mid<_size_p>(b));
-        std::array<double, _size_p> fd_c_double;
-        for (size_t i = 0; i < _size_p; ++i) {
-            fd_c_double[i] = -mid(fd_c[i]);
+        w.before = b;
+        int is_empty;
+        {
+            detail::scoped_timer timer(timed(w.stats.gauss_seidel_time));
+            is_empty = gauss_seidel(f_dd, b, w.gs);
         }
-        if (gauss_seidel(f_dd, fd_c_double, b, c) == 1) {
+        if (is_empty == 1) {
             //Box has been rejected
+            ++w.stats.gauss_seidel_empty;
             return 1;
         }
+        if (this->options.collect_statistics) {
+            record_contraction(b, w);
+        }
+        if ((flags & EVALUATE_VALUE) &&
+            !std::equal(b.begin(), b.end(), w.before.begin())) {
+            //value over the contracted box is tighter
+            evaluate(b, EVALUATE_VALUE, w);
+        }
+    }
+
+    return 0;
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::record_contraction(
+    const box<_size_p>& b, worker& w) const {
+    //mean ratio over the coordinates of some width
+    double ratio = 0;
+    size_t count = 0;
+    for (size_t i = 0; i < b.size(); ++i) {
+        const double before = diam(w.before[i]);
+        if (before > 0 && std::isfinite(before)) {
+            ratio += diam(b[i]) / before;
+            ++count;
+        }
+    }
+    if (count > 0 && ratio < count) {
+        ++w.stats.gauss_seidel_contracted;
+        w.stats.gauss_seidel_width_ratio += ratio / count;
+    }
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+int optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::check_box(
+    box<_size_p>& b, worker& w) {
+    evaluation<_size_p>& e = w.eval;
+    //constraints first, infeasible boxes need no objective
+    const feasibility feasible = check_constraints(b, w);
+    if (feasible == feasibility::INFEASIBLE) {
+        ++w.stats.infeasible;
+        return 1;
     }
 
-    interval t = this->func(b);
-    if (t.lower() > this->f_min) {
+    //value in the pass of the derivatives if the combined callback has it
+    const unsigned value = this->eval_provides & EVALUATE_VALUE;
+    if (check_derivatives(b, w.gradient, w, value,
+                          feasible == feasibility::FEASIBLE)) {
+        return 1;
+    }
+
+    if (!value) {
+        detail::scoped_timer timer(timed(w.stats.func_time));
+        e.value = this->func(b);
+    }
+    const interval& t = e.value;
+    if (t.lower() > this->f_min.load(std::memory_order_relaxed)) {
         //reject box
+        ++w.stats.cutoff;
         return 1;
     }
+    //rank box by its lower bound for best-first search
+    b.set_rank(t.lower());
 
     return 0;
 }
@@ -0,0 +1,124 @@
+#ifndef RapidLab_opt_checkpoint_hpp
+#define RapidLab_opt_checkpoint_hpp
+
+// A checkpoint file holds, after a magic string and the dimension:
+//  - the options that shape the search,
+//  - the incumbent, the lowest bound of boxes closed within tolerance,
+//    the number of boxes processed, the solution and the search box,
+//  - the open boxes as saved by the list, the stack or queue in the order
+//    it is pushed, then the heap in the order of its array.
+// Boxes are streamed from the list to the file, written next to the
+// previous checkpoint and renamed over it once complete.
+namespace detail {
+
+const char checkpoint_magic[8] = {'R', 'L', 'C', 'K', 'P', 'T', '0', '3'};
+
+} // namespace detail
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class list_t>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::save_checkpoint(
+    list_t& list, const worker& w) const {
+    const std::string& path = this->options.checkpoint_file;
+    const std::string partial = path + ".partial";
+    std::vector<char> buffer(1 << 20);
+    std::ofstream out;
+    out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    out.open(partial, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::system_error(errno, std::generic_category(),
+                                "cannot write checkpoint " + partial);
+    }
+
+    out.write(detail::checkpoint_magic, sizeof(detail::checkpoint_magic));
+    detail::write_value(out, static_cast<uint64_t>(w.solution.size()));
+    detail::write_value(out, this->options.epsilon);
+    detail::write_value(out, this->options.bi_mode);
+    detail::write_value(out, static_cast<uint64_t>(this->options.sections));
+    detail::write_value(out, this->options.search);
+    detail::write_value(out, static_cast<uint64_t>(this->options.max_open_boxes));
+
+    detail::write_value(out, this->f_min.load(std::memory_order_relaxed));
+    detail::write_value(out, this->f_closed.load(std::memory_order_relaxed));
+    detail::write_value(out, this->num_boxes + w.num_boxes);
+    detail::write_value(out, w.f_solution);
+    detail::write_box(out, w.solution);
+    detail::write_box(out, this->box0);
+    list.save(out);
+
+    //a failed stream leaves errno unreliable, only rename sets it
+    out.close();
+    if (!out) {
+        std::remove(partial.c_str());
+        throw std::runtime_error("cannot write checkpoint " + partial);
+    }
+    if (std::rename(partial.c_str(), path.c_str()) != 0) {
+        const int error = errno;
+        std::remove(partial.c_str());
+        throw std::system_error(error, std::generic_category(),
+                                "cannot write checkpoint " + path);
+    }
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+box<_size_p> optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::resume(
+    const std::string& path) {
+    this->start_time = std::chrono::high_resolution_clock::now();
+
+    rounding_context<>::scope rounding((rounding_context<>()));
+
+    std::vector<char> buffer(1 << 20);
+    std::ifstream in;
+    in.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    in.open(path, std::ios::binary);
+    if (!in) {
+        throw std::system_error(errno, std::generic_category(),
+                                "cannot read checkpoint " + path);
+    }
+    char magic[sizeof(detail::checkpoint_magic)] = {};
+    in.read(magic, sizeof(magic));
+    if (!std::equal(magic, magic + sizeof(magic), detail::checkpoint_magic)) {
+        throw std::runtime_error("not a checkpoint: " + path);
+    }
+    const size_t n = detail::read_value<uint64_t>(in);
+    if (_size_p != dynamic && n != _size_p) {
+        throw std::runtime_error("checkpoint of other dimension: " + path);
+    }
+
+    this->options.epsilon = detail::read_value<double>(in);
+    this->options.bi_mode = detail::read_value<bisection_mode>(in);
+    this->options.sections = detail::read_value<uint64_t>(in);
+    this->options.search = detail::read_value<search_mode>(in);
+    this->options.max_open_boxes = detail::read_value<uint64_t>(in);
+
+    this->f_min = detail::read_value<double>(in);
+    this->f_closed = detail::read_value<double>(in);
+    this->stopped = stop_reason::COMPLETE;
+    this->num_boxes = detail::read_value<int64_t>(in);
+    std::vector<worker> workers;
+    workers.emplace_back(n);
+    workers[0].f_solution = detail::read_value<double>(in);
+    detail::read_box(in, workers[0].solution, n);
+    detail::read_box(in, this->box0, n);
+
+    //open boxes as they were, compact lists are rebuilt as full ones
+    if (this->options.max_memory_boxes > 0) {
+        spilling_open_list<_size_p> list(this->options, this->f_min);
+        list.load(in, n);
+        if (!in) {
+            throw std::runtime_error("truncated checkpoint: " + path);
+        }
+        search(list, workers[0]);
+    } else {
+        open_list<_size_p> list(this->options, this->f_min);
+        list.load(in, n);
+        if (!in) {
+            throw std::runtime_error("truncated checkpoint: " + path);
+        }
+        search(list, workers[0]);
+    }
+
+    return collect(workers);
+}
+
+#endif
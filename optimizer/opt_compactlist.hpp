@@ -0,0 +1,437 @@
+#ifndef RapidLab_opt_compactlist_hpp
+#define RapidLab_opt_compactlist_hpp
+
+#include <cstdint>
+
+// Open list storing boxes as sections of their parents instead of their
+// bounds. Every bisected box is a node of a tree: the section of its parent
+// it was split from, plus the coordinates its tests contracted since. An
+// open box is a node and the index of its section, 8 bytes whatever the
+// dimension, and its bounds are rebuilt from the root when it is popped.
+// Nodes are shared by all sections of a box and released with the last of
+// them. A box split from a node with no other open section or child is
+// added below the parent of that node, so chains of single boxes leave no
+// nodes behind. Boxes come out in the order and with the bounds of
+// open_list. Popping a box costs a rebuild from its nearest cached
+// ancestor.
+template <size_t _size_p>
+class compact_open_list {
+public:
+    compact_open_list(const options_t& opt, const std::atomic<double>& f_min)
+    : mode(opt.search), max_size(opt.max_open_boxes), f_min(f_min),
+      sections(std::max<size_t>(2, opt.sections)) {
+        if (sections > max_field) {
+            throw std::invalid_argument("compact_boxes needs sections "
+                                        "below 65536");
+        }
+    }
+
+    bool empty() const { return stack.size() == head && heap.empty(); }
+    size_t size() const { return stack.size() - head + heap.size(); }
+
+    // Initial box of the search, the bounds of all others are relative to it
+    void push(const box<_size_p>& b) {
+        assert(empty() && nodes.empty());
+        if (b.size() > max_field) {
+            throw std::invalid_argument("compact_boxes needs a dimension "
+                                        "below 65536");
+        }
+        root = b;
+        push(entry{none, none});
+    }
+
+    // Adds the boxes b is split into along coordinate. b is a box popped
+    // last from the list, after its tests contracted it.
+    void push_sections(const box<_size_p>& b, size_t coordinate) {
+        const uint32_t id = add_node(b, coordinate);
+        nodes[id].refs += static_cast<uint32_t>(sections);
+        nodes[id].open = static_cast<uint16_t>(sections);
+        for (size_t i = 0; i < sections; ++i) {
+            push(entry{id, static_cast<uint32_t>(i)});
+        }
+    }
+
+    // Take the next box to be processed
+    box<_size_p> pop() {
+        entry e;
+        if (mode == search_mode::BREADTH_FIRST) {
+            e = pop_front();
+        } else if (stack.size() > head) {
+            e = stack.back();
+            stack.pop_back();
+            if (stack.size() == head) {
+                stack.clear();
+                head = 0;
+            }
+        } else {
+            e = pop_heap();
+        }
+        if (e.node != none) {
+            --nodes[e.node].open;
+        }
+
+        popped p;
+        p.e = e;
+        p.b = rebuild(e);
+        //the boxes of a block are popped before any of them is split
+        if (recent.size() == box_block<_size_p>::capacity) {
+            release(recent.front().e.node);
+            recent.erase(recent.begin());
+        }
+        recent.push_back(p);
+        return p.b;
+    }
+
+    // Lowest rank of the open boxes
+    double min_rank() const {
+        const lower_rank order(nodes);
+        double r = heap.empty() ? INFINITY : order.rank(heap.front());
+        for (size_t k = head; k < stack.size(); ++k) {
+            r = std::min(r, order.rank(stack[k]));
+        }
+        return r;
+    }
+
+    // Writes the bounds of the open boxes to a checkpoint, as open_list
+    // writes them
+    void save(std::ostream& out) {
+        detail::write_value(out, static_cast<uint64_t>(stack.size() - head));
+        for (size_t k = head; k < stack.size(); ++k) {
+            detail::write_box(out, rebuild(stack[k]));
+        }
+        detail::write_value(out, static_cast<uint64_t>(heap.size()));
+        for (const entry& e : heap) {
+            detail::write_box(out, rebuild(e));
+        }
+    }
+
+private:
+    static const uint32_t none = static_cast<uint32_t>(-1);
+    // Largest section, coordinate and level a node holds
+    static const size_t max_field = UINT16_MAX;
+
+    // Box split from a section of its parent and contracted, 32 bytes
+    struct node {
+        // Lower bound of the function, shared by the sections
+        double rank;
+        // Node this box is a section of, none for the root
+        uint32_t parent;
+        // Sections, popped boxes and nodes referring to this node, or next
+        // free node
+        uint32_t refs;
+        // Contracted coordinates in changed and changes, with the bounds
+        // parents skipped between parent and this node gave
+        uint32_t first_change;
+        uint16_t num_changes;
+        // Section of the split coordinate of parent
+        uint16_t section;
+        // Coordinate the sections of this box are split along
+        uint16_t split;
+        // Splits from the root to this box, also its slot in path
+        uint16_t level;
+        // Sections of this box still in the list
+        uint16_t open;
+    };
+
+    // Open box, section of the split coordinate of node
+    struct entry {
+        uint32_t node;
+        uint32_t section;
+    };
+
+    // Box taken from the list whose sections may still be pushed
+    struct popped {
+        entry e;
+        box<_size_p> b;
+    };
+
+    // Rebuilt box of a node, kept for every level of the last one rebuilt
+    struct cached {
+        uint32_t id;
+        box<_size_p> b;
+    };
+
+    search_mode mode;
+    size_t max_size;
+    const std::atomic<double>& f_min;
+    size_t sections;
+
+    box<_size_p> root;
+    std::vector<node> nodes;
+    uint32_t free_node = none;
+    // Bounds of contracted coordinates and their indices
+    std::vector<interval> changes;
+    std::vector<uint32_t> changed;
+    // Changes of released nodes, dropped when they outgrow the others
+    size_t unused_changes = 0;
+
+    std::vector<entry> stack;
+    size_t head = 0;
+    std::vector<entry> heap;
+    std::vector<popped> recent;
+    // Boxes of the levels of the last node rebuilt, none for levels its
+    // ancestors skip. Slots past path_size keep their storage for the next.
+    std::vector<cached> path;
+    size_t path_size = 0;
+    std::vector<uint32_t> chain;
+    // Section of a parent that a skipped node was split from
+    box<_size_p> skipped;
+
+    void push(const entry& e) {
+        if (mode == search_mode::BEST_FIRST ||
+            (mode == search_mode::HYBRID && is_diving_done())) {
+            heap.push_back(e);
+            std::push_heap(heap.begin(), heap.end(), lower_rank(nodes));
+        } else {
+            stack.push_back(e);
+        }
+    }
+
+    // Orders entries as open_list orders boxes, by the rank of their node
+    struct lower_rank {
+        const std::vector<node>& nodes;
+        explicit lower_rank(const std::vector<node>& n) : nodes(n) {}
+        double rank(const entry& e) const {
+            return e.node == none ? -INFINITY : nodes[e.node].rank;
+        }
+        bool operator()(const entry& a, const entry& b) const {
+            return rank(b) < rank(a);
+        }
+    };
+
+    bool is_diving_done() const {
+        return f_min.load(std::memory_order_relaxed) < INFINITY &&
+            heap.size() < max_size;
+    }
+
+    entry pop_front() {
+        entry e = stack[head++];
+        if (head == stack.size()) {
+            stack.clear();
+            head = 0;
+        } else if (head > 1024 && 2 * head > stack.size()) {
+            //release the consumed front of the queue
+            stack.erase(stack.begin(), stack.begin() + head);
+            head = 0;
+        }
+        return e;
+    }
+
+    entry pop_heap() {
+        std::pop_heap(heap.begin(), heap.end(), lower_rank(nodes));
+        entry e = heap.back();
+        heap.pop_back();
+        return e;
+    }
+
+    static bool is_subset(const box<_size_p>& a, const box<_size_p>& b) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].lower() < b[i].lower() || a[i].upper() > b[i].upper()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint32_t add_node(const box<_size_p>& b, size_t coordinate) {
+        //any recent box containing b gives exact bounds, the latest is
+        //the parent of a depth-first search
+        size_t k = recent.size() - 1;
+        while (k > 0 && !is_subset(b, recent[k].b)) {
+            --k;
+        }
+        assert(is_subset(b, recent[k].b));
+        const popped& p = recent[k];
+
+        const size_t level = b.get_depth() - root.get_depth();
+        if (level > max_field) {
+            throw std::runtime_error("compact_boxes split a box more than "
+                                     "65535 times");
+        }
+        node n;
+        n.rank = b.get_rank();
+        n.parent = p.e.node;
+        n.section = n.parent == none ? 0 : static_cast<uint16_t>(p.e.section);
+        n.split = static_cast<uint16_t>(coordinate);
+        n.level = static_cast<uint16_t>(level);
+        n.refs = 0;
+        n.open = 0;
+        n.first_change = static_cast<uint32_t>(changes.size());
+        n.num_changes = 0;
+        //skip a parent no other box needs, b keeps the bounds it gave
+        const box<_size_p>* base = &p.b;
+        if (n.parent != none && is_only_child(n.parent)) {
+            const node& skip = nodes[n.parent];
+            n.parent = skip.parent;
+            n.section = skip.section;
+            base = &section_box(n.parent, n.section);
+        }
+        for (size_t i = 0; i < b.size(); ++i) {
+            if (b[i] != (*base)[i]) {
+                changes.push_back(b[i]);
+                changed.push_back(static_cast<uint32_t>(i));
+                ++n.num_changes;
+            }
+        }
+        if (n.parent != none) {
+            ++nodes[n.parent].refs;
+        }
+
+        uint32_t id = free_node;
+        if (id == none) {
+            id = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(n);
+        } else {
+            free_node = nodes[id].refs;
+            nodes[id] = n;
+        }
+
+        //depth-first search pops a section of b next
+        if (path_size >= level && is_cached(n.parent)) {
+            path_size = level;
+            push_path(id) = b;
+        }
+        return id;
+    }
+
+    // Whether node id has no open sections and no boxes split from it, so
+    // only the boxes popped from it still refer to it
+    bool is_only_child(uint32_t id) const {
+        const node& n = nodes[id];
+        if (n.open > 0) {
+            return false;
+        }
+        uint32_t refs = 0;
+        for (const popped& r : recent) {
+            refs += r.e.node == id;
+        }
+        return n.refs == refs;
+    }
+
+    // Whether the box of node id is in path, always for the root
+    bool is_cached(uint32_t id) const {
+        if (id == none) {
+            return true;
+        }
+        const size_t level = nodes[id].level;
+        return level < path_size && path[level].id == id;
+    }
+
+    // Bounds of section i of the box of node id, the root for none
+    const box<_size_p>& section_box(uint32_t id, size_t i) {
+        if (id == none) {
+            return root;
+        }
+        skipped = node_box(id);
+        const node& n = nodes[id];
+        skipped[n.split] = detail::section(skipped[n.split], i, sections);
+        return skipped;
+    }
+
+    void release(uint32_t id) {
+        while (id != none && --nodes[id].refs == 0) {
+            node& n = nodes[id];
+            if (is_cached(id)) {
+                path_size = n.level;
+            }
+            unused_changes += n.num_changes;
+            const uint32_t parent = n.parent;
+            n.refs = free_node;
+            n.num_changes = 0;
+            free_node = id;
+            id = parent;
+        }
+        if (unused_changes > 1024 && 2 * unused_changes > changes.size()) {
+            compact_changes();
+        }
+    }
+
+    // Drops the changes of released nodes
+    void compact_changes() {
+        std::vector<interval> kept;
+        std::vector<uint32_t> kept_changed;
+        kept.reserve(changes.size() - unused_changes);
+        kept_changed.reserve(changes.size() - unused_changes);
+        for (node& n : nodes) {
+            const uint32_t first = static_cast<uint32_t>(kept.size());
+            for (uint32_t k = 0; k < n.num_changes; ++k) {
+                kept.push_back(changes[n.first_change + k]);
+                kept_changed.push_back(changed[n.first_change + k]);
+            }
+            n.first_change = first;
+        }
+        changes.swap(kept);
+        changed.swap(kept_changed);
+        unused_changes = 0;
+    }
+
+    // Bounds of node id, rebuilt from the deepest of its ancestors in path
+    const box<_size_p>& node_box(uint32_t id) {
+        chain.clear();
+        for (uint32_t a = id; !is_cached(a); a = nodes[a].parent) {
+            chain.push_back(a);
+        }
+        if (chain.empty()) {
+            return path[nodes[id].level].b;
+        }
+        path_size = nodes[chain.back()].level;
+
+        for (size_t k = chain.size(); k-- > 0;) {
+            const node& n = nodes[chain[k]];
+            //levels n skipped keep no box
+            while (path_size < n.level) {
+                push_path(none);
+            }
+            box<_size_p>& b = push_path(chain[k]);
+            if (n.parent == none) {
+                b = root;
+            } else {
+                const node& parent = nodes[n.parent];
+                b = path[parent.level].b;
+                b[parent.split] =
+                    detail::section(b[parent.split], n.section, sections);
+            }
+            for (uint32_t c = 0; c < n.num_changes; ++c) {
+                b[changed[n.first_change + c]] = changes[n.first_change + c];
+            }
+            b.set_depth(root.get_depth() + n.level);
+            b.set_rank(n.rank);
+        }
+        return path[path_size - 1].b;
+    }
+
+    // Box of the next level of path, given to node id
+    box<_size_p>& push_path(uint32_t id) {
+        if (path_size == path.size()) {
+            path.emplace_back();
+        }
+        cached& c = path[path_size++];
+        c.id = id;
+        return c.b;
+    }
+
+    box<_size_p> rebuild(const entry& e) {
+        if (e.node == none) {
+            return root;
+        }
+        box<_size_p> b(node_box(e.node));
+        const node& n = nodes[e.node];
+        b[n.split] = detail::section(b[n.split], e.section, sections);
+        b.set_depth(root.get_depth() + n.level + 1);
+        return b;
+    }
+};
+
+namespace detail {
+
+template <size_t _size_p>
+inline void push_sections(compact_open_list<_size_p>& list,
+                          const box<_size_p>& b, size_t coordinate,
+                          size_t sections) {
+    assert(sections == std::max<size_t>(2, sections));
+    list.push_sections(b, coordinate);
+}
+
+} // namespace detail
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef RapidLab_opt_constraints_hpp
+#define RapidLab_opt_constraints_hpp
+
+// Bounds the constraints over b until one is certainly violated, equality
+// constraints numbered after the inequalities. They are checked cheapest
+// first: by the seconds a thread spent in each per box it rejected, which
+// orders independent tests by their expected cost of rejecting a box, and
+// re-sorted every 64 boxes.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+typename optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::feasibility
+optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::check_constraints(
+    const box<_size_p>& b, worker& w) {
+    const size_t num_inequalities = this->constraints.size();
+    const size_t num_constraints = num_inequalities + this->equalities.size();
+    if (num_constraints == 0) {
+        return feasibility::FEASIBLE;
+    }
+    std::vector<constraint_cost>& costs = w.constraint_costs;
+    std::vector<size_t>& order = w.constraint_order;
+    if (order.size() != num_constraints) {
+        costs.assign(num_constraints, constraint_cost());
+        w.constraint_values.resize(num_constraints);
+        order.resize(num_constraints);
+        for (size_t k = 0; k < order.size(); ++k) {
+            order[k] = k;
+        }
+    }
+    if (++w.constraint_checks % 64 == 0) {
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t c) {
+                             return costs[a].seconds * (costs[c].rejected + 1) <
+                                 costs[c].seconds * (costs[a].rejected + 1);
+                         });
+    }
+
+    feasibility result = feasibility::FEASIBLE;
+    for (size_t k : order) {
+        const bool is_equality = k >= num_inequalities;
+        interval g;
+        {
+            detail::scoped_timer timer(&costs[k].seconds);
+            g = is_equality ? this->equalities[k - num_inequalities].h(b) :
+                this->constraints[k](b);
+        }
+        w.constraint_values[k] = g;
+        if (g.lower() > 0 || (is_equality && g.upper() < 0)) {
+            ++costs[k].rejected;
+            return feasibility::INFEASIBLE;
+        }
+        if (!(g.upper() <= 0) || (is_equality && !(g.lower() >= 0))) {
+            result = feasibility::UNDECIDED;
+        }
+    }
+    return result;
+}
+
+// Whether all inequality constraints certainly hold over m, a point or
+// the box of verify_feasible_box
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+bool optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::is_feasible_point(
+    const box<_size_p>& m, worker& w) const {
+    const std::vector<size_t>& order = w.constraint_order;
+    const size_t num_constraints = order.empty() ?
+        this->constraints.size() : order.size();
+    for (size_t k = 0; k < num_constraints; ++k) {
+        const size_t c = order.empty() ? k : order[k];
+        if (c < this->constraints.size() &&
+            !(this->constraints[c](m).upper() <= 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Evaluates the equality constraints and their gradients at the point
+// w.equality.point and takes the Newton step on the free coordinates
+// towards their zero into step, leaving the factorized Jacobian in lu.
+// Free coordinates are chosen once, as the pivot columns of the Jacobian
+// at the candidate.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::equality_newton_step(
+    worker& w, bool choose_free) {
+    equality_workspace& q = w.equality;
+    const size_t n = q.point.size();
+    const size_t k = this->equalities.size();
+    for (size_t j = 0; j < k; ++j) {
+        q.values[j] = this->equalities[j].h(q.point);
+        q.residual(j) = mid(q.values[j]);
+        const vector_t g = this->equalities[j].h_d(q.point);
+        for (size_t i = 0; i < n; ++i) {
+            q.jacobian(j, i) = mid(g[i]);
+        }
+    }
+    if (choose_free) {
+        q.lu.compute(q.jacobian);
+        q.free.resize(k);
+        for (size_t i = 0; i < k; ++i) {
+            q.free[i] = q.lu.permutationQ().indices()(i);
+        }
+    }
+    for (size_t l = 0; l < k; ++l) {
+        q.jacobian_free.col(l) = q.jacobian.col(q.free[l]);
+    }
+    q.lu.compute(q.jacobian_free);
+    q.step = q.lu.solve(q.residual);
+}
+
+// Proves that a point satisfying the equality constraints lies in a small
+// box around candidate m and inside the search box. Newton steps move the
+// free coordinates of m towards the constraints, then the Krawczyk
+// operator
+//   K(X) = x - C h(x) + (I - C h'(X)) (X - x)
+// over a box X around the iterate x, with C the inverse of the midpoint
+// Jacobian at x, lies in the interior of X only if X holds a unique zero of
+// h over the free coordinates. X is widened tenfold up to twice if not.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+bool optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::verify_feasible_box(
+    const box<_size_p>& m, worker& w) {
+    equality_workspace& q = w.equality;
+    const size_t n = m.size();
+    const size_t k = this->equalities.size();
+    if (k > n) {
+        return false;
+    }
+    q.jacobian.resize(k, n);
+    q.jacobian_free.resize(k, k);
+    q.residual.resize(k);
+    q.values.resize(k);
+    q.gradients.resize(k);
+    q.krawczyk.resize(k);
+
+    q.point = m;
+    for (int iteration = 0; ; ++iteration) {
+        equality_newton_step(w, iteration == 0);
+        if (!q.lu.isInvertible() || !q.step.allFinite()) {
+            ++w.stats.existence_failures;
+            return false;
+        }
+        if (iteration == 8 ||
+            q.step.cwiseAbs().maxCoeff() <= 1e-15 * (1 + q.residual.norm())) {
+            break;
+        }
+        for (size_t l = 0; l < k; ++l) {
+            const size_t i = q.free[l];
+            q.point[i] = interval(mid(q.point[i]) - q.step(l));
+        }
+    }
+    q.inverse = q.lu.inverse();
+
+    q.feasible = q.point;
+    double scale = 1;
+    for (int attempt = 0; attempt < 3; ++attempt, scale *= 10) {
+        for (size_t l = 0; l < k; ++l) {
+            const size_t i = q.free[l];
+            const double x = mid(q.point[i]);
+            const double r = scale * (10 * std::abs(q.step(l)) +
+                                      1e-9 * (1 + std::abs(x)));
+            q.feasible[i] = interval(x - r, x + r);
+        }
+        for (size_t j = 0; j < k; ++j) {
+            q.gradients[j] = this->equalities[j].h_d(q.feasible);
+        }
+
+        bool is_interior = true;
+        for (size_t l = 0; l < k && is_interior; ++l) {
+            const size_t i = q.free[l];
+            interval& K = q.krawczyk[l];
+            K = q.point[i];
+            for (size_t j = 0; j < k; ++j) {
+                K -= q.inverse(l, j) * q.values[j];
+            }
+            for (size_t c = 0; c < k; ++c) {
+                interval M(l == c ? 1.0 : 0.0);
+                for (size_t j = 0; j < k; ++j) {
+                    M -= q.inverse(l, j) * q.gradients[j][q.free[c]];
+                }
+                K += M * (q.feasible[q.free[c]] - q.point[q.free[c]]);
+            }
+            is_interior = K.lower() > q.feasible[i].lower() &&
+                K.upper() < q.feasible[i].upper();
+        }
+        if (is_interior) {
+            //the zero has to lie in the search box as well
+            for (size_t i = 0; i < n; ++i) {
+                if (q.feasible[i].lower() < this->box0[i].lower() ||
+                    q.feasible[i].upper() > this->box0[i].upper()) {
+                    ++w.stats.existence_failures;
+                    return false;
+                }
+            }
+            ++w.stats.existence_proofs;
+            return true;
+        }
+    }
+    ++w.stats.existence_failures;
+    return false;
+}
+
+#endif
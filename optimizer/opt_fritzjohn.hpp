@@ -0,0 +1,129 @@
+#ifndef RapidLab_opt_fritzjohn_hpp
+#define RapidLab_opt_fritzjohn_hpp
+
+// Whether b certainly holds no point of the Fritz John conditions
+//   u0 f'(x) + sum u_i g_i'(x) + sum v_j h_j'(x) = 0,
+//   u0 + sum u_i + sum |v_j| = 1,
+// with u0, u_i >= 0 and u_i = 0 for inequalities inactive over b, which
+// every constrained minimum satisfies. For each sign of the v_j the system
+// is linear in the multipliers with interval coefficients over b, and b
+// holds no such point once all are found to have no solution. Skipped if
+// a gradient of a constraint that may be active is not given, or for more
+// than 4 equalities.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+int optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::fritz_john(
+    const box<_size_p>& b, const vector_t& f_d, worker& w) {
+    fritz_john_workspace& fj = w.fritz_john;
+    const size_t num_inequalities = this->constraints.size();
+    const size_t num_equalities = this->equalities.size();
+    if (num_equalities > 4) {
+        return 0;
+    }
+    for (size_t i = 0; i < num_inequalities; ++i) {
+        if (!(w.constraint_values[i].upper() < 0) &&
+            !this->constraint_gradients[i]) {
+            return 0;
+        }
+    }
+
+    fj.gradients.clear();
+    fj.gradients.push_back(f_d);
+    for (size_t i = 0; i < num_inequalities; ++i) {
+        if (!(w.constraint_values[i].upper() < 0)) {
+            fj.gradients.push_back(this->constraint_gradients[i](b));
+        }
+    }
+    for (const equality& e : this->equalities) {
+        fj.gradients.push_back(e.h_d(b));
+    }
+
+    for (unsigned signs = 0; signs < (1u << num_equalities); ++signs) {
+        if (!has_no_multipliers(fj, b.size(), num_equalities, signs)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Whether the system with the equality multipliers of signs (bit j set for
+// v_j <= 0) has no solution. With s_j v_j in place of v_j all multipliers
+// lie in [0,1], and interval Gauss-Seidel preconditioned by the
+// pseudo-inverse of the midpoint system contracts them, together with the
+// normalization, until one is empty.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+bool optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::has_no_multipliers(
+    fritz_john_workspace& fj, size_t n, size_t num_equalities,
+    unsigned signs) const {
+    const size_t q = fj.gradients.size();
+    const size_t first_equality = q - num_equalities;
+    fj.A.resize(n + 1, q);
+    fj.mid_matrix.resize(n + 1, q);
+    for (size_t c = 0; c < q; ++c) {
+        const bool is_negative = c >= first_equality &&
+            (signs >> (c - first_equality) & 1);
+        for (size_t r = 0; r < n; ++r) {
+            fj.A(r, c) = is_negative ? -fj.gradients[c][r] : fj.gradients[c][r];
+            fj.mid_matrix(r, c) = mid(fj.A(r, c));
+        }
+        fj.A(n, c) = interval(1);
+        fj.mid_matrix(n, c) = 1;
+    }
+
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd(
+        fj.mid_matrix, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    const Eigen::VectorXd& sigma = svd.singularValues();
+    Eigen::VectorXd inverse_sigma(sigma.size());
+    for (int k = 0; k < sigma.size(); ++k) {
+        inverse_sigma(k) = sigma(k) > 1e-12 * sigma(0) ? 1 / sigma(k) : 0;
+    }
+    fj.C = svd.matrixV() * inverse_sigma.asDiagonal() *
+        svd.matrixU().transpose();
+    if (!fj.C.allFinite()) {
+        return false;
+    }
+
+    fj.CA.resize(q, q);
+    for (size_t l = 0; l < q; ++l) {
+        for (size_t c = 0; c < q; ++c) {
+            interval sum(0);
+            for (size_t r = 0; r <= n; ++r) {
+                sum += fj.C(l, r) * fj.A(r, c);
+            }
+            fj.CA(l, c) = sum;
+        }
+    }
+
+    fj.multipliers.assign(q, interval(0, 1));
+    std::vector<interval>& u = fj.multipliers;
+    for (int sweep = 0; sweep < 2; ++sweep) {
+        for (size_t l = 0; l < q; ++l) {
+            //right hand side is 1 in the normalization only
+            if (!zero_in(fj.CA(l, l))) {
+                interval numerator(fj.C(l, n));
+                for (size_t c = 0; c < q; ++c) {
+                    if (c != l) {
+                        numerator -= fj.CA(l, c) * u[c];
+                    }
+                }
+                u[l] = intersect(numerator / fj.CA(l, l), u[l]);
+                if (std::isnan(u[l].lower())) {
+                    return true;
+                }
+            }
+            //and the normalization itself
+            interval rest(1);
+            for (size_t c = 0; c < q; ++c) {
+                if (c != l) {
+                    rest -= u[c];
+                }
+            }
+            u[l] = intersect(rest, u[l]);
+            if (std::isnan(u[l].lower())) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#endif
@@ -1,43 +1,43 @@
 #ifndef RapidLab_opt_gaussseidel_hpp
 #define RapidLab_opt_gaussseidel_hpp
 
-template <size_t _size_p>
-int optimizer<_size_p>::gauss_seidel(
-    const Eigen::Matrix<interval, _size_p, _size_p>& A,
-    const std::array<double, _size_p>& b,
-    box<_size_p>& x,
-    const std::array<double, _size_p>& x_tilda) const {
-
-    Eigen::Matrix<double, _size_p, _size_p> mid_matrix;
-    for (size_t k = 0; k < _size_p; ++k) {
-        for (size_t j = 0; j < _size_p; ++j) {
-            mid_matrix(j,k) = mid(A(j,k));
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+int optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::gauss_seidel(
+    const matrix_t& A, box<_size_p>& x, gauss_seidel_workspace& ws) const {
+    const size_t n = x.size();
+    const point_t& x_tilda = ws.x_tilda;
+
+    //small dynamic systems at the fixed sizes
+    if (!detail::precondition_small(A, ws.rhs, ws.CA, ws.Cb)) {
+        for (size_t k = 0; k < n; ++k) {
+            for (size_t j = 0; j < n; ++j) {
+                ws.mid_matrix(j,k) = mid(A(j,k));
+            }
+        }
+        if (detail::matrix_size<_size_p>::value != Eigen::Dynamic) {
+            ws.C = ws.mid_matrix.inverse();
+        } else {
+            //factorization in the workspace instead of a temporary
+            ws.lu.compute(ws.mid_matrix);
+            ws.C = ws.lu.inverse();
         }
-    }
 
-    Eigen::Matrix<double, _size_p, _size_p> C = mid_matrix.inverse();
+        //preconditioned system in midpoint-radius products
+        mid_rad_product(ws.C, A, ws.CA, ws.CA_product);
+        mid_rad_product(ws.C, ws.rhs, ws.Cb, ws.Cb_product);
+    }
+    const matrix_t& CA = ws.CA;
+    const detail::column_vector<_size_p>& Cb = ws.Cb;
 
-    for (size_t k = 0; k < _size_p; ++k) {
+    for (size_t k = 0; k < n; ++k) {
         interval sum(0);
-        for (size_t j = 0; j < _size_p; j++) {
+        for (size_t j = 0; j < n; j++) {
             if (j != k) {
-                interval A_aux(0);
-                for (size_t i = 0; i < _size_p; i++) {
-                    A_aux += C(k,i) * A(i,j);
-                }
-                sum += A_aux * (x[j] - x_tilda[j]);
+                sum += CA(k,j) * (x[j] - x_tilda[j]);
             }
         }
-        interval b_aux(0);
-        for (size_t i = 0; i < _size_p; i++) {
-            b_aux += C(k,i) * b[i];
-        }
-        interval numerator = (-b_aux + sum);
-        interval A_aux(0);
-        for (size_t i = 0; i < _size_p; i++) {
-            A_aux += C(k,i) * A(i,k);
-        }
-        interval denominator = A_aux;
+        interval numerator = (-Cb(k) + sum);
+        interval denominator = CA(k,k);
 
         if (!zero_in(intersect(numerator, denominator))) {
             if (!zero_in(denominator)) {
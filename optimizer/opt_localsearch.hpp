@@ -0,0 +1,142 @@
+#ifndef RapidLab_opt_localsearch_hpp
+#define RapidLab_opt_localsearch_hpp
+
+// Due after every local_search_boxes bisected boxes and after any midpoint
+// that lowered the incumbent
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+bool optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::wants_local_search(
+    worker& w, bool is_improved) const {
+    if (this->options.local_search_boxes <= 0 || !has_gradient()) {
+        return false;
+    }
+    if (++w.since_local_search < this->options.local_search_boxes &&
+        !is_improved) {
+        return false;
+    }
+    w.since_local_search = 0;
+    return true;
+}
+
+// Upper bound of the function at point x, from its interval value
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class V>
+double optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::point_value(
+    const V& x, worker& w) {
+    box<_size_p>& p = w.local.point;
+    for (size_t i = 0; i < p.size(); ++i) {
+        p[i] = interval(x(i));
+    }
+    detail::scoped_timer timer(timed(w.stats.func_time));
+    const double f = this->func(p).upper();
+    return std::isnan(f) ? INFINITY : f;
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+template <class V>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::point_gradient(
+    const V& x, V& g, worker& w) {
+    box<_size_p>& p = w.local.point;
+    for (size_t i = 0; i < p.size(); ++i) {
+        p[i] = interval(x(i));
+    }
+    evaluate(p, EVALUATE_GRADIENT, w);
+    for (size_t i = 0; i < p.size(); ++i) {
+        g(i) = mid(w.eval.gradient[i]);
+    }
+}
+
+// Descends from the midpoint of b within b, by Newton steps where the
+// Hessian is given and positive definite and by BFGS steps otherwise,
+// each backtracked until the value decreases enough. Only the interval
+// value at the point reached lowers the incumbent, so it stays rigorous
+// whatever the rounding of the steps.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::local_search(
+    const box<_size_p>& b, worker& w) {
+    local_search_workspace& l = w.local;
+    const size_t n = b.size();
+    ++w.stats.local_searches;
+
+    for (size_t i = 0; i < n; ++i) {
+        l.x(i) = mid(b[i]);
+    }
+    double f = point_value(l.x, w);
+    point_gradient(l.x, l.g, w);
+    l.H.setIdentity();
+
+    const bool newton = has_hessian();
+    for (unsigned step = 0; step < this->options.local_search_steps &&
+         f < INFINITY; ++step) {
+        bool is_newton_step = false;
+        if (newton) {
+            for (size_t i = 0; i < n; ++i) {
+                l.point[i] = interval(l.x(i));
+            }
+            evaluate(l.point, EVALUATE_HESSIAN, w);
+            for (size_t j = 0; j < n; ++j) {
+                for (size_t i = 0; i < n; ++i) {
+                    l.A(i, j) = mid(w.eval.hessian(i, j));
+                }
+            }
+            l.ldlt.compute(l.A);
+            if (l.ldlt.info() == Eigen::Success &&
+                l.ldlt.vectorD().minCoeff() > 0) {
+                l.d = l.ldlt.solve(-l.g);
+                is_newton_step = true;
+            }
+        }
+        if (!is_newton_step) {
+            l.d.noalias() = -(l.H * l.g);
+        }
+        double slope = l.g.dot(l.d);
+        if (!(slope < 0)) {
+            //steepest descent if the estimate is no descent direction
+            l.d = -l.g;
+            slope = -l.g.squaredNorm();
+            if (!(slope < 0)) {
+                break;
+            }
+        }
+
+        //backtrack along the direction projected onto b
+        double f_next = INFINITY;
+        bool is_accepted = false;
+        double t = 1;
+        for (int k = 0; k < 30 && !is_accepted; ++k, t *= 0.5) {
+            for (size_t i = 0; i < n; ++i) {
+                l.x_next(i) = std::min(std::max(l.x(i) + t * l.d(i),
+                                                b[i].lower()), b[i].upper());
+            }
+            l.s = l.x_next - l.x;
+            f_next = point_value(l.x_next, w);
+            is_accepted = f_next <= f + 1e-4 * l.g.dot(l.s);
+        }
+        if (!is_accepted || l.s.squaredNorm() == 0) {
+            break;
+        }
+
+        point_gradient(l.x_next, l.g_next, w);
+        l.y = l.g_next - l.g;
+        const double sy = l.s.dot(l.y);
+        if (sy > 1e-12 * l.s.norm() * l.y.norm()) {
+            //BFGS update of the inverse Hessian
+            l.Hy.noalias() = l.H * l.y;
+            const double yHy = l.y.dot(l.Hy);
+            l.H.noalias() += ((sy + yHy) / (sy * sy)) * (l.s * l.s.transpose());
+            l.H.noalias() -= (l.Hy * l.s.transpose() +
+                              l.s * l.Hy.transpose()) / sy;
+        }
+        l.x = l.x_next;
+        l.g = l.g_next;
+        f = f_next;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        l.point[i] = interval(l.x(i));
+    }
+    if (update_minimum(w, l.point, f, false)) {
+        ++w.stats.local_improvements;
+    }
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef RapidLab_opt_openlist_hpp
+#define RapidLab_opt_openlist_hpp
+
+// List of boxes still to be processed, ordered by the search mode.
+// Boxes are ranked by the lower bound of the function over the box.
+template <size_t _size_p>
+class open_list {
+public:
+    open_list(const options_t& opt, const std::atomic<double>& f_min)
+    : mode(opt.search), max_size(opt.max_open_boxes), f_min(f_min) {}
+
+    bool empty() const { return stack.size() == head && heap.empty(); }
+    size_t size() const { return stack.size() - head + heap.size(); }
+
+    void push(const box<_size_p>& b) { push_box(b); }
+    // Takes the storage of b, no copy for boxes of dynamic dimension
+    void push(box<_size_p>&& b) { push_box(std::move(b)); }
+
+    // Take the next box to be processed by the owner of the list
+    box<_size_p> pop() {
+        box<_size_p> b;
+        if (mode == search_mode::BREADTH_FIRST) {
+            b = pop_front();
+        } else if (stack.size() > head) {
+            b = std::move(stack.back());
+            stack.pop_back();
+            if (stack.size() == head) {
+                stack.clear();
+                head = 0;
+            }
+        } else {
+            b = pop_heap();
+        }
+        return b;
+    }
+
+    // Take a box to be processed by another thread, preferring large boxes
+    box<_size_p> steal() {
+        box<_size_p> b;
+        if (!heap.empty()) {
+            b = pop_heap();
+        } else {
+            b = pop_front();
+        }
+        return b;
+    }
+
+    // Lowest rank of the open boxes, a lower bound of the function over
+    // all of them
+    double min_rank() const {
+        double r = heap.empty() ? INFINITY : heap.front().get_rank();
+        for (size_t k = head; k < stack.size(); ++k) {
+            r = std::min(r, stack[k].get_rank());
+        }
+        return r;
+    }
+
+    // Writes the open boxes to a checkpoint, the stack or queue in the
+    // order it was pushed, then the heap in the order of its array
+    void save(std::ostream& out) const {
+        detail::write_value(out, static_cast<uint64_t>(stack.size() - head));
+        for (size_t k = head; k < stack.size(); ++k) {
+            detail::write_box(out, stack[k]);
+        }
+        detail::write_value(out, static_cast<uint64_t>(heap.size()));
+        for (const box<_size_p>& b : heap) {
+            detail::write_box(out, b);
+        }
+    }
+
+    // Adds the boxes of dimension n written by save
+    void load(std::istream& in, size_t n) {
+        box<_size_p> b;
+        for (uint64_t k = detail::read_value<uint64_t>(in); k > 0 && in; --k) {
+            detail::read_box(in, b, n);
+            stack.push_back(b);
+        }
+        //a heap array pushed in order stays as it was
+        for (uint64_t k = detail::read_value<uint64_t>(in); k > 0 && in; --k) {
+            detail::read_box(in, b, n);
+            heap.push_back(b);
+            std::push_heap(heap.begin(), heap.end(), lower_rank);
+        }
+    }
+
+private:
+    search_mode mode;
+    size_t max_size;
+    const std::atomic<double>& f_min;
+
+    // Depth-first stack or breadth-first queue starting at head,
+    // also used by hybrid dives
+    std::vector<box<_size_p>> stack;
+    size_t head = 0;
+    // Best-first heap, the box with the lowest rank on top
+    std::vector<box<_size_p>> heap;
+
+    static bool lower_rank(const box<_size_p>& a, const box<_size_p>& b) {
+        return b < a;
+    }
+
+    template <class B>
+    void push_box(B&& b) {
+        if (mode == search_mode::BEST_FIRST ||
+            (mode == search_mode::HYBRID && is_diving_done())) {
+            heap.push_back(std::forward<B>(b));
+            std::push_heap(heap.begin(), heap.end(), lower_rank);
+        } else {
+            stack.push_back(std::forward<B>(b));
+        }
+    }
+
+    // Hybrid search dives depth-first until an incumbent exists
+    // and whenever the heap exceeds the memory cap
+    bool is_diving_done() const {
+        return f_min.load(std::memory_order_relaxed) < INFINITY &&
+            heap.size() < max_size;
+    }
+
+    box<_size_p> pop_front() {
+        box<_size_p> b = std::move(stack[head++]);
+        if (head == stack.size()) {
+            stack.clear();
+            head = 0;
+        } else if (head > 1024 && 2 * head > stack.size()) {
+            //release the consumed front of the queue
+            stack.erase(stack.begin(), stack.begin() + head);
+            head = 0;
+        }
+        return b;
+    }
+
+    box<_size_p> pop_heap() {
+        std::pop_heap(heap.begin(), heap.end(), lower_rank);
+        box<_size_p> b = std::move(heap.back());
+        heap.pop_back();
+        return b;
+    }
+};
+
+#endif
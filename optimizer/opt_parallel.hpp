@@ -0,0 +1,167 @@
+#ifndef RapidLab_opt_parallel_hpp
+#define RapidLab_opt_parallel_hpp
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::solve_parallel(
+    const box<_size_p>& box0, std::vector<worker>& workers) {
+    // Every thread owns an open list it takes boxes from in search order,
+    // idle threads steal from the lists of others (see open_list::steal)
+    struct shared_list {
+        shared_list(const options_t& opt, const std::atomic<double>& f_min)
+        : boxes(opt, f_min) {}
+        std::mutex lock;
+        open_list<_size_p> boxes;
+    };
+    const size_t num_threads = workers.size();
+    std::vector<std::unique_ptr<shared_list>> lists;
+    for (size_t id = 0; id < num_threads; ++id) {
+        lists.emplace_back(new shared_list(this->options, this->f_min));
+    }
+
+    // Boxes waiting in any list or being processed. Children are counted
+    // before their parent is released, so zero means the search is done.
+    std::atomic<int64_t> pending(1);
+    lists[0]->boxes.push(box0);
+    // Lowest rank of the boxes each thread took from a list until their
+    // children are in its own, so a bound over all lists misses none
+    std::vector<detail::shared_double> in_flight(
+        num_threads, detail::shared_double(INFINITY));
+
+    // Boxes processed by all threads, and whether a limit stops them
+    std::atomic<int64_t> processed(this->num_boxes);
+    std::atomic<bool> stop(false);
+    auto request_stop = [&](stop_reason reason) {
+        bool running = false;
+        if (stop.compare_exchange_strong(running, true)) {
+            this->stopped = reason;
+        }
+    };
+    const int64_t progress_boxes = this->func_progress ?
+        this->options.progress_boxes : 0;
+    std::mutex progress_lock;
+
+    // Number and lowest rank of the open boxes, with all lists locked
+    auto lowest_open = [&]() {
+        std::vector<std::unique_lock<std::mutex>> locked;
+        for (const std::unique_ptr<shared_list>& l : lists) {
+            locked.emplace_back(l->lock);
+        }
+        size_t count = 0;
+        double rank = INFINITY;
+        for (const std::unique_ptr<shared_list>& l : lists) {
+            count += l->boxes.size();
+            rank = std::min(rank, l->boxes.min_rank());
+        }
+        for (const detail::shared_double& r : in_flight) {
+            rank = std::min(rank, r.load(std::memory_order_relaxed));
+        }
+        return std::make_pair(count, rank);
+    };
+
+    // Worker threads start in round to nearest, install rounding state
+    const rounding_context<> context;
+
+    // Blocks of boxes are taken at once when bounded by the batch function
+    const size_t block_size = this->func_batch ? box_block<_size_p>::capacity : 1;
+
+    auto pop = [&](size_t id, std::vector<box<_size_p>>& boxes) {
+        std::lock_guard<std::mutex> guard(lists[id]->lock);
+        double rank = INFINITY;
+        while (!lists[id]->boxes.empty() && boxes.size() < block_size) {
+            boxes.push_back(lists[id]->boxes.pop());
+            rank = std::min(rank, boxes.back().get_rank());
+        }
+        in_flight[id] = rank;
+        return !boxes.empty();
+    };
+
+    auto steal = [&](size_t id, std::vector<box<_size_p>>& boxes) {
+        for (size_t k = 1; k < num_threads; ++k) {
+            shared_list& victim = *lists[(id + k) % num_threads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.boxes.empty()) {
+                boxes.push_back(victim.boxes.steal());
+                in_flight[id] = boxes.back().get_rank();
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto run = [&](size_t id) {
+        rounding_context<>::scope rounding(context);
+        worker& w = workers[id];
+        struct {
+            std::vector<box<_size_p>> boxes;
+            void push(const box<_size_p>& c) { boxes.push_back(c); }
+        } children;
+        std::vector<box<_size_p>> boxes;
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            boxes.clear();
+            if (!pop(id, boxes) && !steal(id, boxes)) {
+                if (pending.load(std::memory_order_acquire) == 0) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            const size_t num_taken = boxes.size();
+
+            children.boxes.clear();
+            if (this->func_batch) {
+                process_block(boxes, w, children);
+            } else {
+                process_box(boxes[0], w, children);
+            }
+
+            if (!children.boxes.empty()) {
+                const int64_t open = pending.fetch_add(
+                    children.boxes.size(), std::memory_order_relaxed);
+                if (this->options.collect_statistics) {
+                    //counts the boxes being processed as open
+                    w.stats.peak_open_boxes = std::max(w.stats.peak_open_boxes,
+                        static_cast<size_t>(open) + children.boxes.size());
+                }
+                std::lock_guard<std::mutex> guard(lists[id]->lock);
+                for (const box<_size_p>& c : children.boxes) {
+                    lists[id]->boxes.push(c);
+                }
+            }
+            pending.fetch_sub(num_taken, std::memory_order_release);
+            in_flight[id] = INFINITY;
+
+            const int64_t taken = static_cast<int64_t>(num_taken);
+            const int64_t done = processed.fetch_add(
+                taken, std::memory_order_relaxed) + taken;
+            const stop_reason reason = limit_reached(done,
+                pending.load(std::memory_order_relaxed), w.center.size());
+            if (reason != stop_reason::COMPLETE) {
+                request_stop(reason);
+            }
+            if (progress_boxes > 0 && done / progress_boxes !=
+                (done - taken) / progress_boxes) {
+                std::lock_guard<std::mutex> reporting(progress_lock);
+                const std::pair<size_t, double> open = lowest_open();
+                if (!report_progress(done, open.first, open.second)) {
+                    request_stop(stop_reason::PROGRESS);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t id = 1; id < num_threads; ++id) {
+        threads.emplace_back(run, id);
+    }
+    run(0);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    const std::pair<size_t, double> open = lowest_open();
+    this->num_open = open.first;
+    this->f_open = open.second;
+}
+
+#endif
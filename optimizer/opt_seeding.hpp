@@ -0,0 +1,126 @@
+#ifndef RapidLab_opt_seeding_hpp
+#define RapidLab_opt_seeding_hpp
+
+namespace detail {
+
+// The first n primes, bases of the Halton sequence in n dimensions
+inline std::vector<unsigned> first_primes(size_t n) {
+    std::vector<unsigned> primes;
+    for (unsigned k = 2; primes.size() < n; ++k) {
+        bool is_prime = true;
+        for (size_t j = 0; j < primes.size() && primes[j] * primes[j] <= k; ++j) {
+            if (k % primes[j] == 0) {
+                is_prime = false;
+                break;
+            }
+        }
+        if (is_prime) {
+            primes.push_back(k);
+        }
+    }
+    return primes;
+}
+
+// Digits of k in base mirrored at the radix point, in [0,1)
+inline double radical_inverse(uint64_t k, unsigned base) {
+    double r = 0;
+    double digit = 1.0 / base;
+    while (k > 0) {
+        r += digit * (k % base);
+        k /= base;
+        digit /= base;
+    }
+    return r;
+}
+
+// Point k of the Halton sequence scaled to b, kept inside b whatever the
+// rounding
+template <size_t _size_p>
+inline void halton_point(const box<_size_p>& b, uint64_t k,
+                         const std::vector<unsigned>& bases, box<_size_p>& p) {
+    for (size_t i = 0; i < b.size(); ++i) {
+        const double x = b[i].lower() +
+            radical_inverse(k, bases[i]) * (b[i].upper() - b[i].lower());
+        p[i] = interval(std::min(x, b[i].upper()));
+    }
+}
+
+} // namespace detail
+
+// Evaluates the function at the first seed_points points of the Halton
+// sequence over box0, skipping its corner at the origin of the sequence.
+// Every point lower than the incumbent replaces it, so the cut-off test
+// prunes from the first box on.
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::seed_incumbent(
+    const box<_size_p>& box0, std::vector<worker>& workers) {
+    const int64_t count = this->options.seed_points;
+    if (count <= 0) {
+        return;
+    }
+    const std::vector<unsigned> bases = detail::first_primes(box0.size());
+    const int64_t num_threads = static_cast<int64_t>(workers.size());
+    if (num_threads == 1) {
+        seed_range(box0, bases, 1, count + 1, workers[0]);
+        return;
+    }
+
+    //consecutive ranges of points for every thread
+    const rounding_context<> context;
+    auto run = [&](int64_t id) {
+        rounding_context<>::scope rounding(context);
+        seed_range(box0, bases, 1 + count * id / num_threads,
+                   1 + count * (id + 1) / num_threads, workers[id]);
+    };
+    std::vector<std::thread> threads;
+    for (int64_t id = 1; id < num_threads; ++id) {
+        threads.emplace_back(run, id);
+    }
+    run(0);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::seed_range(
+    const box<_size_p>& box0, const std::vector<unsigned>& bases,
+    int64_t begin, int64_t end, worker& w) {
+    box<_size_p>& p = w.center;
+    if (!this->func_batch) {
+        for (int64_t k = begin; k < end; ++k) {
+            detail::halton_point(box0, k, bases, p);
+            double f;
+            {
+                detail::scoped_timer timer(timed(w.stats.func_time));
+                f = this->func(p).upper();
+            }
+            update_minimum(w, p, f, false);
+        }
+        return;
+    }
+
+    //points in the boxes of a block, bounded in one call
+    w.block.clear();
+    for (int64_t k = begin; k < end; ++k) {
+        detail::halton_point(box0, k, bases, p);
+        w.block.push_back(p);
+        if (!w.block.full() && k + 1 < end) {
+            continue;
+        }
+        const size_t size = w.block.size();
+        w.block.pad();
+        {
+            detail::scoped_timer timer(timed(w.stats.func_time));
+            this->func_batch(w.block, w.bounds.data());
+        }
+        for (size_t j = 0; j < size; ++j) {
+            if (w.bounds[j].upper() < this->f_min.load(std::memory_order_relaxed)) {
+                update_minimum(w, w.block.get(j), w.bounds[j].upper(), false);
+            }
+        }
+        w.block.clear();
+    }
+}
+
+#endif
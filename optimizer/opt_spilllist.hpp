@@ -0,0 +1,455 @@
+#ifndef RapidLab_opt_spilllist_hpp
+#define RapidLab_opt_spilllist_hpp
+
+namespace detail {
+
+// Temporary file mapped into memory in slots of equal size. The file is
+// unlinked as soon as it is created, so it goes away with the process.
+// Slots written or read are dropped from the resident set with evict, the
+// kernel writes them back and reads them in again on access.
+class spill_file {
+public:
+    spill_file(const std::string& directory, size_t bytes_per_slot) {
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        slot_bytes = (bytes_per_slot + page - 1) / page * page;
+
+        std::string dir = directory;
+        if (dir.empty()) {
+            const char* tmp = std::getenv("TMPDIR");
+            dir = tmp ? tmp : "/tmp";
+        }
+        std::string path = dir + "/rapidlab_spill_XXXXXX";
+        std::vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+        fd = mkstemp(name.data());
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "cannot create spill file in " + dir);
+        }
+        unlink(name.data());
+    }
+
+    ~spill_file() {
+        if (map) {
+            munmap(map, capacity * slot_bytes);
+        }
+        close(fd);
+    }
+
+    spill_file(const spill_file&) = delete;
+    spill_file& operator=(const spill_file&) = delete;
+
+    size_t allocate() {
+        if (!free_slots.empty()) {
+            size_t slot = free_slots.back();
+            free_slots.pop_back();
+            return slot;
+        }
+        if (num_slots == capacity) {
+            grow(std::max<size_t>(4, 2 * capacity));
+        }
+        return num_slots++;
+    }
+
+    void release(size_t slot) {
+        evict(slot, 0, slot_bytes);
+        free_slots.push_back(slot);
+    }
+
+    char* data(size_t slot) { return map + slot * slot_bytes; }
+
+    // Drops the whole pages of bytes [begin, end) of slot from memory
+    void evict(size_t slot, size_t begin, size_t end) {
+        const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        begin = (begin + page - 1) / page * page;
+        end = end / page * page;
+        if (begin < end) {
+            madvise(data(slot) + begin, end - begin, MADV_DONTNEED);
+        }
+    }
+
+private:
+    int fd = -1;
+    char* map = nullptr;
+    size_t slot_bytes;
+    size_t num_slots = 0;
+    size_t capacity = 0;
+    std::vector<size_t> free_slots;
+
+    void grow(size_t slots) {
+        if (ftruncate(fd, static_cast<off_t>(slots * slot_bytes)) != 0) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "cannot grow spill file");
+        }
+        if (map) {
+            munmap(map, capacity * slot_bytes);
+        }
+        void* p = mmap(nullptr, slots * slot_bytes, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            map = nullptr;
+            throw std::system_error(errno, std::generic_category(),
+                                    "cannot map spill file");
+        }
+        map = static_cast<char*>(p);
+        capacity = slots;
+    }
+};
+
+} // namespace detail
+
+// Open list keeping at most options_t::max_memory_boxes boxes in memory,
+// the others in a spill_file. Boxes are written and read back in segments
+// of half that many, in order:
+//  - the depth-first stack spills its bottom, read back when the stack
+//    runs empty,
+//  - the breadth-first queue spills its middle, read back when the boxes
+//    in front of it are done,
+//  - the best-first heap spills its worst half as a run sorted by rank,
+//    merged back while the head of a run ranks below the top of the heap.
+// So boxes come out in the order of open_list, up to boxes of equal rank.
+template <size_t _size_p>
+class spilling_open_list {
+public:
+    spilling_open_list(const options_t& opt, const std::atomic<double>& f_min)
+    : mode(opt.search), max_size(opt.max_open_boxes), f_min(f_min),
+      max_memory(std::max<size_t>(2, opt.max_memory_boxes)),
+      segment(max_memory / 2), directory(opt.spill_directory) {
+        stack.reserve(max_memory + 1);
+        tail.reserve(max_memory + 1);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t size() const {
+        return stack.size() - head + tail.size() + heap.size() + spilled;
+    }
+
+    void push(const box<_size_p>& b) {
+        if (dimension == 0) {
+            dimension = b.size();
+        }
+        if (mode == search_mode::BEST_FIRST ||
+            (mode == search_mode::HYBRID && is_diving_done())) {
+            push_heap(b);
+        } else {
+            push_stack(b);
+        }
+    }
+
+    // Take the next box to be processed
+    box<_size_p> pop() {
+        box<_size_p> b;
+        if (mode == search_mode::BREADTH_FIRST) {
+            b = pop_front();
+        } else if (stack.size() > head || !segments.empty()) {
+            if (stack.empty()) {
+                read(segments.back(), stack);
+                segments.pop_back();
+            }
+            b = std::move(stack.back());
+            stack.pop_back();
+        } else {
+            b = pop_heap();
+        }
+        return b;
+    }
+
+    // Lowest rank of the open boxes, spilled ones by that of their segment
+    double min_rank() const {
+        double r = heap.empty() ? INFINITY : heap.front().get_rank();
+        for (size_t k = head; k < stack.size(); ++k) {
+            r = std::min(r, stack[k].get_rank());
+        }
+        for (const box<_size_p>& b : tail) {
+            r = std::min(r, b.get_rank());
+        }
+        for (const spilled_segment& s : segments) {
+            r = std::min(r, s.rank);
+        }
+        for (const spilled_segment& s : runs) {
+            r = std::min(r, s.rank);
+        }
+        return r;
+    }
+
+    // Writes the open boxes to a checkpoint as open_list does, the spilled
+    // runs of the heap after its array
+    void save(std::ostream& out) {
+        detail::write_value(out, static_cast<uint64_t>(
+            size() - heap.size() - heap_spilled));
+        if (mode == search_mode::BREADTH_FIRST) {
+            save(out, stack.begin() + head, stack.end());
+            for (const spilled_segment& s : segments) {
+                save(out, s);
+            }
+            save(out, tail.begin(), tail.end());
+        } else {
+            //bottom of the stack first
+            for (const spilled_segment& s : segments) {
+                save(out, s);
+            }
+            save(out, stack.begin(), stack.end());
+        }
+        detail::write_value(out, static_cast<uint64_t>(
+            heap.size() + heap_spilled));
+        save(out, heap.begin(), heap.end());
+        for (const spilled_segment& s : runs) {
+            save(out, s);
+        }
+    }
+
+    // Adds the boxes of dimension n written by save
+    void load(std::istream& in, size_t n) {
+        dimension = n;
+        box<_size_p> b;
+        for (uint64_t k = detail::read_value<uint64_t>(in); k > 0 && in; --k) {
+            detail::read_box(in, b, n);
+            push_stack(b);
+        }
+        for (uint64_t k = detail::read_value<uint64_t>(in); k > 0 && in; --k) {
+            detail::read_box(in, b, n);
+            push_heap(b);
+        }
+    }
+
+private:
+    // Boxes written to a slot of the file, from next on not read back yet
+    struct spilled_segment {
+        size_t slot;
+        size_t next;
+        size_t count;
+        // Lowest rank of the boxes from next on, that of box next in a
+        // sorted run
+        double rank;
+    };
+
+    search_mode mode;
+    size_t max_size;
+    const std::atomic<double>& f_min;
+    size_t max_memory;
+    size_t segment;
+    std::string directory;
+    size_t dimension = 0;
+
+    std::unique_ptr<detail::spill_file> file;
+    // Boxes in the file
+    size_t spilled = 0;
+
+    // Depth-first stack, or front of the breadth-first queue from head
+    std::vector<box<_size_p>> stack;
+    size_t head = 0;
+    // Segments spilled from the bottom of the stack, or the middle of the
+    // queue in the order they are read back
+    std::deque<spilled_segment> segments;
+    // Back of the queue, pushed after segments
+    std::vector<box<_size_p>> tail;
+    // Best-first heap and the runs spilled from it
+    std::vector<box<_size_p>> heap;
+    std::vector<spilled_segment> runs;
+    size_t heap_spilled = 0;
+
+    static bool lower_rank(const box<_size_p>& a, const box<_size_p>& b) {
+        return b < a;
+    }
+
+    void push_heap(const box<_size_p>& b) {
+        heap.push_back(b);
+        std::push_heap(heap.begin(), heap.end(), lower_rank);
+        if (heap.size() > max_memory) {
+            spill_heap();
+        }
+    }
+
+    void push_stack(const box<_size_p>& b) {
+        if (mode == search_mode::BREADTH_FIRST &&
+            (!segments.empty() || !tail.empty())) {
+            //behind the spilled segments of the queue
+            tail.push_back(b);
+            if (stack.size() - head + tail.size() > max_memory &&
+                tail.size() >= segment) {
+                segments.push_back(write(tail.begin(), tail.begin() + segment));
+                tail.erase(tail.begin(), tail.begin() + segment);
+            }
+        } else {
+            stack.push_back(b);
+            if (stack.size() - head > max_memory) {
+                spill_stack();
+            }
+        }
+    }
+
+    template <class It>
+    void save(std::ostream& out, It begin, It end) const {
+        for (It it = begin; it != end; ++it) {
+            detail::write_box(out, *it);
+        }
+    }
+
+    void save(std::ostream& out, const spilled_segment& s) {
+        box<_size_p> b;
+        const char* p = file->data(s.slot) + s.next * record_bytes();
+        for (size_t k = s.next; k < s.count; ++k, p += record_bytes()) {
+            read_box(p, b);
+            detail::write_box(out, b);
+        }
+        file->evict(s.slot, 0, s.count * record_bytes());
+    }
+
+    bool is_diving_done() const {
+        return f_min.load(std::memory_order_relaxed) < INFINITY &&
+            heap.size() + heap_spilled < max_size;
+    }
+
+    // Bounds followed by rank and depth, sizes are multiples of an interval
+    size_t record_bytes() const { return (dimension + 1) * sizeof(interval); }
+
+    template <class It>
+    spilled_segment write(It begin, It end) {
+        const size_t count = static_cast<size_t>(end - begin);
+        if (!file) {
+            file.reset(new detail::spill_file(
+                directory, segment * record_bytes()));
+        }
+        const size_t slot = file->allocate();
+        char* p = file->data(slot);
+        double min_rank = INFINITY;
+        for (It it = begin; it != end; ++it, p += record_bytes()) {
+            std::copy(it->begin(), it->end(), reinterpret_cast<interval*>(p));
+            const double rank = it->get_rank();
+            min_rank = std::min(min_rank, rank);
+            const unsigned depth = it->get_depth();
+            char* extra = p + dimension * sizeof(interval);
+            std::memcpy(extra, &rank, sizeof(rank));
+            std::memcpy(extra + sizeof(rank), &depth, sizeof(depth));
+        }
+        //written back by the kernel, no longer resident here
+        file->evict(slot, 0, count * record_bytes());
+        spilled += count;
+        spilled_segment s = {slot, 0, count, min_rank};
+        return s;
+    }
+
+    void read_box(const char* p, box<_size_p>& b) const {
+        detail::resize(b, dimension);
+        const interval* bounds = reinterpret_cast<const interval*>(p);
+        std::copy(bounds, bounds + dimension, b.begin());
+        double rank;
+        unsigned depth;
+        const char* extra = p + dimension * sizeof(interval);
+        std::memcpy(&rank, extra, sizeof(rank));
+        std::memcpy(&depth, extra + sizeof(rank), sizeof(depth));
+        b.set_rank(rank);
+        b.set_depth(depth);
+    }
+
+    double rank_at(const spilled_segment& s) const {
+        double rank;
+        std::memcpy(&rank, file->data(s.slot) + s.next * record_bytes() +
+                    dimension * sizeof(interval), sizeof(rank));
+        return rank;
+    }
+
+    // Appends the boxes of s to boxes and frees its slot
+    void read(const spilled_segment& s, std::vector<box<_size_p>>& boxes) {
+        const char* p = file->data(s.slot);
+        const size_t first = boxes.size();
+        boxes.resize(first + s.count);
+        for (size_t k = 0; k < s.count; ++k, p += record_bytes()) {
+            read_box(p, boxes[first + k]);
+        }
+        file->release(s.slot);
+        spilled -= s.count;
+    }
+
+    void spill_stack() {
+        if (mode == search_mode::BREADTH_FIRST) {
+            //back of the queue, read back after its front
+            segments.push_back(write(stack.end() - segment, stack.end()));
+            stack.erase(stack.end() - segment, stack.end());
+        } else {
+            //bottom of the stack, read back when the rest is done
+            segments.push_back(write(stack.begin(), stack.begin() + segment));
+            stack.erase(stack.begin(), stack.begin() + segment);
+        }
+    }
+
+    void spill_heap() {
+        //worst boxes first
+        std::sort_heap(heap.begin(), heap.end(), lower_rank);
+        //as a run of increasing rank
+        std::reverse(heap.begin(), heap.begin() + segment);
+        runs.push_back(write(heap.begin(), heap.begin() + segment));
+        heap_spilled += segment;
+        heap.erase(heap.begin(), heap.begin() + segment);
+        std::make_heap(heap.begin(), heap.end(), lower_rank);
+    }
+
+    box<_size_p> pop_front() {
+        if (stack.size() == head) {
+            stack.clear();
+            head = 0;
+            if (!segments.empty()) {
+                read(segments.front(), stack);
+                segments.pop_front();
+            } else {
+                stack.swap(tail);
+            }
+        }
+        box<_size_p> b = std::move(stack[head++]);
+        if (head == stack.size()) {
+            stack.clear();
+            head = 0;
+        } else if (head > 1024 && 2 * head > stack.size()) {
+            //release the consumed front of the queue
+            stack.erase(stack.begin(), stack.begin() + head);
+            head = 0;
+        }
+        return b;
+    }
+
+    box<_size_p> pop_heap() {
+        //merge runs while one has a box ranked below the top of the heap
+        while (!runs.empty()) {
+            size_t best = 0;
+            for (size_t k = 1; k < runs.size(); ++k) {
+                if (runs[k].rank < runs[best].rank) {
+                    best = k;
+                }
+            }
+            if (!heap.empty() && !(runs[best].rank < heap.front().get_rank())) {
+                break;
+            }
+            read_run(best);
+        }
+
+        std::pop_heap(heap.begin(), heap.end(), lower_rank);
+        box<_size_p> b = std::move(heap.back());
+        heap.pop_back();
+        return b;
+    }
+
+    // Moves the next boxes of run k to the heap
+    void read_run(size_t k) {
+        spilled_segment& s = runs[k];
+        const size_t count = std::min(s.count - s.next,
+                                      std::max<size_t>(1, segment / 4));
+        const char* p = file->data(s.slot) + s.next * record_bytes();
+        for (size_t i = 0; i < count; ++i, p += record_bytes()) {
+            heap.emplace_back();
+            read_box(p, heap.back());
+            std::push_heap(heap.begin(), heap.end(), lower_rank);
+        }
+        s.next += count;
+        spilled -= count;
+        heap_spilled -= count;
+        if (s.next == s.count) {
+            file->release(s.slot);
+            runs.erase(runs.begin() + k);
+        } else {
+            file->evict(s.slot, 0, s.next * record_bytes());
+            s.rank = rank_at(s);
+        }
+    }
+};
+
+#endif
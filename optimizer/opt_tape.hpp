@@ -0,0 +1,29 @@
+#ifndef RapidLab_opt_tape_hpp
+#define RapidLab_opt_tape_hpp
+
+template <size_t _size_p, class _func_p, class _func_d_p, class _func_dd_p>
+void optimizer<_size_p, _func_p, _func_d_p, _func_dd_p>::set_tape(const tape& t) {
+    //replayed by every worker, each with its own sweep buffers
+    std::shared_ptr<const tape> recorded = std::make_shared<tape>(t);
+
+    //one forward sweep shared by all orders
+    set_combined_function([recorded](const box<_size_p>& b, unsigned flags,
+                                     evaluation<_size_p>& e) {
+        thread_local tape::sweep s;
+        interval f = s.forward(*recorded, b);
+        if (flags & EVALUATE_VALUE) {
+            e.value = f;
+        }
+        if (flags & EVALUATE_GRADIENT) {
+            s.gradient(e.gradient.data());
+        }
+        if (flags & EVALUATE_HESSIAN) {
+            //columns are contiguous in the column-major matrix
+            for (size_t j = 0; j < _size_p; ++j) {
+                s.hessian_column(j, e.hessian.col(j).data());
+            }
+        }
+    });
+}
+
+#endif
@@ -3,68 +3,812 @@
 
 #include "interval/core.hpp"
 #include "interval/box.hpp"
+#include "interval/box_block.hpp"
+#include "interval/dual.hpp"
+#include "interval/tape.hpp"
 #include "interval/eigen_support.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
 #include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 namespace rapidlab {
 
 enum class bisection_mode {
     MAX_DIAM,
-    MAX_SMEAR_DIAM
+    // Largest |gradient| times width, requires the first derivative
+    MAX_SMEAR_DIAM,
+    // Cycles through the coordinates with increasing box depth
+    ROUND_ROBIN,
+    // Largest width relative to the magnitude of the coordinate
+    MAX_RELATIVE_DIAM
+};
+
+enum class search_mode {
+    DEPTH_FIRST,
+    BEST_FIRST,
+    BREADTH_FIRST,
+    // Depth-first until an incumbent exists, then best-first
+    HYBRID
+};
+
+// How derivatives of objectives written for any scalar type are computed
+enum class differentiation {
+    // Gradient by dual numbers
+    FORWARD,
+    // Gradient and Hessian by a tape recorded once
+    REVERSE
 };
 
 struct options_t {
     double epsilon = 1e-3;
     bisection_mode bi_mode = bisection_mode::MAX_DIAM;
+    // Number of pieces a box is split into along the chosen coordinate
+    size_t sections = 2;
+    search_mode search = search_mode::DEPTH_FIRST;
+    // Size of the best-first heap above which HYBRID dives depth-first
+    size_t max_open_boxes = 1 << 20;
+    // Number of worker threads, 0 uses all hardware threads
+    unsigned threads = 1;
+    differentiation diff_mode = differentiation::FORWARD;
+    // Store open boxes as sections of their parents in a tree instead of
+    // their bounds (see compact_open_list). Single-threaded solves only,
+    // solve throws std::invalid_argument with more threads.
+    bool compact_boxes = false;
+    // Open boxes kept in memory, the others are spilled to a file (see
+    // spilling_open_list), 0 keeps all. Single-threaded solves only, as
+    // compact_boxes.
+    size_t max_memory_boxes = 0;
+    // Directory of the spill file, TMPDIR or /tmp if empty
+    std::string spill_directory;
+    // File the state of the search is written to every checkpoint_boxes
+    // boxes, to be continued by optimizer::resume. Each checkpoint is a full
+    // snapshot of the open boxes, not the changes since the last, and
+    // compact ones are written with their bounds. Single-threaded solves
+    // only, as compact_boxes, and none is written if either is unset.
+    std::string checkpoint_file;
+    int64_t checkpoint_boxes = 0;
+    // Collect the timings, contractions, open list size and incumbents of
+    // solve_statistics, its counts are always kept
+    bool collect_statistics = false;
+    // Limits on seconds, boxes processed and bytes of open boxes at which
+    // solve returns the incumbent early (see optimizer::lower_bound), 0
+    // leaves a limit unset. Open boxes count with the size of a box, also
+    // when stored compactly or spilled.
+    double max_time = 0;
+    int64_t max_boxes = 0;
+    size_t max_memory = 0;
+    // Boxes between calls of the progress function
+    int64_t progress_boxes = 0;
+    // Bisected boxes between local searches from the midpoint, which also
+    // follow every midpoint that lowers the incumbent. 0 runs none, they
+    // need the gradient.
+    int64_t local_search_boxes = 0;
+    // Descent steps of a local search
+    unsigned local_search_steps = 20;
+    // Points of the Halton sequence over the initial box evaluated before
+    // branching, the lowest seeds the incumbent. They are spread over the
+    // threads and, given a batch function, over the boxes of its blocks.
+    int64_t seed_points = 0;
+};
+
+// Why a solve returned
+enum class stop_reason {
+    // No open boxes are left
+    COMPLETE,
+    TIME,
+    BOXES,
+    MEMORY,
+    // The progress function asked to stop
+    PROGRESS
+};
+
+// State of a running solve passed to the progress function
+struct solve_progress {
+    int64_t boxes;
+    size_t open_boxes;
+    // Seconds since the start of the solve
+    double time;
+    // Incumbent, and a lower bound of the global minimum
+    double minimum;
+    double lower_bound;
+    double gap;
 };
 
+// What the tests of a solve did and where its time went
+struct solve_statistics {
+    // Boxes rejected by each test, within tolerance or bisected, adding up
+    // to the boxes processed
+    int64_t infeasible = 0;
+    int64_t monotonicity = 0;
+    int64_t nonconvexity = 0;
+    int64_t gauss_seidel_empty = 0;
+    int64_t fritz_john_empty = 0;
+    int64_t cutoff = 0;
+    int64_t tolerance = 0;
+    int64_t bisected = 0;
+    // Boxes Gauss-Seidel contracted, and the sum over them of the mean
+    // ratio of widths after to before
+    int64_t gauss_seidel_contracted = 0;
+    double gauss_seidel_width_ratio = 0;
+    // Seconds in the callbacks, summed over threads. A combined callback
+    // counts as the highest order it evaluates.
+    double func_time = 0;
+    double func_d_time = 0;
+    double func_dd_time = 0;
+    double gauss_seidel_time = 0;
+    double bisection_time = 0;
+    // Largest number of open boxes at once
+    size_t peak_open_boxes = 0;
+    // Local searches run, and those that lowered the incumbent
+    int64_t local_searches = 0;
+    int64_t local_improvements = 0;
+    // Candidates for the incumbent near which a point satisfying the
+    // equality constraints was proved to exist, and those where it was not
+    int64_t existence_proofs = 0;
+    int64_t existence_failures = 0;
+
+    // Incumbent after each improvement
+    struct incumbent {
+        // Seconds since the start of the solve
+        double time;
+        // Boxes processed before, by the finding thread in parallel solves
+        int64_t boxes;
+        double value;
+    };
+    std::vector<incumbent> incumbents;
+
+    // Adds the statistics of another thread
+    void merge(const solve_statistics& s) {
+        infeasible += s.infeasible;
+        monotonicity += s.monotonicity;
+        nonconvexity += s.nonconvexity;
+        gauss_seidel_empty += s.gauss_seidel_empty;
+        fritz_john_empty += s.fritz_john_empty;
+        cutoff += s.cutoff;
+        tolerance += s.tolerance;
+        bisected += s.bisected;
+        gauss_seidel_contracted += s.gauss_seidel_contracted;
+        gauss_seidel_width_ratio += s.gauss_seidel_width_ratio;
+        func_time += s.func_time;
+        func_d_time += s.func_d_time;
+        func_dd_time += s.func_dd_time;
+        gauss_seidel_time += s.gauss_seidel_time;
+        bisection_time += s.bisection_time;
+        peak_open_boxes = std::max(peak_open_boxes, s.peak_open_boxes);
+        local_searches += s.local_searches;
+        local_improvements += s.local_improvements;
+        existence_proofs += s.existence_proofs;
+        existence_failures += s.existence_failures;
+
+        //improvements of all threads in time, each below the last
+        std::vector<incumbent> all(incumbents);
+        all.insert(all.end(), s.incumbents.begin(), s.incumbents.end());
+        std::sort(all.begin(), all.end(),
+                  [](const incumbent& a, const incumbent& b) {
+                      return a.time < b.time;
+                  });
+        incumbents.clear();
+        for (const incumbent& i : all) {
+            if (incumbents.empty() || i.value < incumbents.back().value) {
+                incumbents.push_back(i);
+            }
+        }
+    }
+};
+
+// Orders requested from, or provided by, a combined evaluation
+enum evaluation_order : unsigned {
+    EVALUATE_VALUE = 1,
+    EVALUATE_GRADIENT = 2,
+    EVALUATE_HESSIAN = 4,
+    EVALUATE_ALL = 7
+};
+
+namespace detail {
+
+// Eigen size of vectors and matrices over boxes of _size_p coordinates
 template <size_t _size_p>
+struct matrix_size : std::integral_constant<int, static_cast<int>(_size_p)> {};
+template <>
+struct matrix_size<dynamic> : std::integral_constant<int, Eigen::Dynamic> {};
+
+template <size_t _size_p, class T = interval>
+using square_matrix = Eigen::Matrix<T,
+    matrix_size<_size_p>::value, matrix_size<_size_p>::value>;
+
+template <size_t _size_p, class T = interval>
+using column_vector = Eigen::Matrix<T, matrix_size<_size_p>::value, 1>;
+
+// Preconditioned system C*A and C*b of gauss_seidel, with C the inverse of
+// the midpoint of A, for a dynamic matrix of at most four rows. Computed in
+// matrices of these sizes fixed at compile time, which Eigen inverts in
+// closed form and multiplies without loops over run-time sizes.
+template <int _rows, class MA, class VB, class MC, class VC>
+inline void precondition_fixed(const MA& A, const VB& b, MC& CA, VC& Cb) {
+    using interval_matrix = Eigen::Matrix<interval, _rows, _rows>;
+    using double_matrix = Eigen::Matrix<double, _rows, _rows>;
+    using double_vector = Eigen::Matrix<double, _rows, 1>;
+    const interval_matrix a = A;
+    double_matrix m;
+    for (int k = 0; k < _rows; ++k) {
+        for (int j = 0; j < _rows; ++j) {
+            m(j,k) = mid(a(j,k));
+        }
+    }
+    const double_matrix C = m.inverse();
+    const double_vector rhs = b;
+
+    interval_matrix ca;
+    Eigen::Matrix<interval, _rows, 1> cb;
+    mid_rad_workspace<double_matrix, interval_matrix> ca_product;
+    mid_rad_workspace<double_matrix, double_vector> cb_product;
+    mid_rad_product(C, a, ca, ca_product);
+    mid_rad_product(C, rhs, cb, cb_product);
+    CA = ca;
+    Cb = cb;
+}
+
+// Fixed sizes go through the general path of gauss_seidel
+template <class MA, class VB, class MC, class VC>
+inline bool precondition_small(const MA&, const VB&, MC&, VC&,
+                               std::false_type) {
+    return false;
+}
+
+template <class MA, class VB, class MC, class VC>
+inline bool precondition_small(const MA& A, const VB& b, MC& CA, VC& Cb,
+                               std::true_type) {
+    switch (A.rows()) {
+    case 1: precondition_fixed<1>(A, b, CA, Cb); return true;
+    case 2: precondition_fixed<2>(A, b, CA, Cb); return true;
+    case 3: precondition_fixed<3>(A, b, CA, Cb); return true;
+    case 4: precondition_fixed<4>(A, b, CA, Cb); return true;
+    case 5: precondition_fixed<5>(A, b, CA, Cb); return true;
+    case 6: precondition_fixed<6>(A, b, CA, Cb); return true;
+    case 7: precondition_fixed<7>(A, b, CA, Cb); return true;
+    case 8: precondition_fixed<8>(A, b, CA, Cb); return true;
+    default: return false;
+    }
+}
+
+template <class MA, class VB, class MC, class VC>
+inline bool precondition_small(const MA& A, const VB& b, MC& CA, VC& Cb) {
+    return precondition_small(A, b, CA, Cb, std::integral_constant<bool,
+        MA::RowsAtCompileTime == Eigen::Dynamic>());
+}
+
+// Objectives for any scalar type need a dimension fixed at compile time
+template <class F, size_t _size_p>
+struct is_fixed_objective : is_objective<F, _size_p> {};
+template <class F>
+struct is_fixed_objective<F, dynamic> : std::false_type {};
+
+} // namespace detail
+
+// Enclosures of the function, its gradient and its Hessian over a box.
+// Filled by a combined evaluation, only the requested orders are written.
+template <size_t _size_p>
+struct evaluation {
+    interval value;
+    typename box<_size_p>::vector_t gradient;
+    detail::square_matrix<_size_p> hessian;
+};
+
+namespace detail {
+
+// Stands in for a derivative that is not given
+template <class R>
+struct no_function {
+    template <class... A>
+    R operator()(const A&...) const {
+        assert(false && "derivative not given");
+        return R();
+    }
+};
+
+// Whether a callback has been given
+template <class S>
+inline bool is_set(const std::function<S>& f) { return bool(f); }
+template <class R>
+inline bool is_set(const no_function<R>&) { return false; }
+template <class R, class... A>
+inline bool is_set(R (*f)(A...)) { return f != nullptr; }
+template <class F>
+inline bool is_set(const F&) { return true; }
+
+// Copies keep the value, so an optimizer can be returned by value
+struct shared_double : std::atomic<double> {
+    using std::atomic<double>::operator=;
+    shared_double(double a) : std::atomic<double>(a) {}
+    shared_double(const shared_double& a)
+    : std::atomic<double>(a.load(std::memory_order_relaxed)) {}
+};
+
+// Bound i of the sections of equal width x is split into, from the lower
+// bound of x at 0 to its upper bound at sections
+inline double section_bound(const interval& x, size_t i, size_t sections) {
+    const double l = x.lower();
+    const double u = x.upper();
+    double bound = l;
+    for (size_t k = 1; k <= i; ++k) {
+        double next = u;
+        if (k < sections) {
+            next = (k * 2 == sections) ? mid(x) :
+                l + (u - l) * (static_cast<double>(k) / sections);
+            next = std::min(std::max(next, bound), u);
+        }
+        bound = next;
+    }
+    return bound;
+}
+
+// Section i of x split into sections of equal width
+inline interval section(const interval& x, size_t i, size_t sections) {
+    return interval(section_bound(x, i, sections),
+                    section_bound(x, i + 1, sections));
+}
+
+// Adds the boxes b is split into along coordinate to list, the last one
+// in the storage of b
+template <class list_t, size_t _size_p>
+inline void push_sections(list_t& list, box<_size_p> b,
+                          size_t coordinate, size_t sections) {
+    const interval whole = b[coordinate];
+    b.set_depth(b.get_depth() + 1);
+    for (size_t i = 0; i + 1 < sections; ++i) {
+        b[coordinate] = section(whole, i, sections);
+        list.push(b);
+    }
+    b[coordinate] = section(whole, sections - 1, sections);
+    list.push(std::move(b));
+}
+
+// Adds the seconds from its construction to its destruction to *seconds,
+// times nothing if seconds is null
+class scoped_timer {
+public:
+    explicit scoped_timer(double* seconds) : seconds(seconds) {
+        if (seconds) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+    ~scoped_timer() {
+        if (seconds) {
+            *seconds += std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+private:
+    double* seconds;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Values and boxes of checkpoint files, in the byte order of the machine
+template <class T>
+inline void write_value(std::ostream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template <class T>
+inline T read_value(std::istream& in) {
+    T v = T();
+    in.read(reinterpret_cast<char*>(&v), sizeof(v));
+    return v;
+}
+
+template <size_t _size_p>
+inline void write_box(std::ostream& out, const box<_size_p>& b) {
+    for (const interval& x : b) {
+        write_value(out, x.lower());
+        write_value(out, x.upper());
+    }
+    write_value(out, b.get_rank());
+    write_value(out, static_cast<uint64_t>(b.get_depth()));
+}
+
+template <size_t _size_p>
+inline void read_box(std::istream& in, box<_size_p>& b, size_t n) {
+    resize(b, n);
+    for (size_t i = 0; i < n; ++i) {
+        const double l = read_value<double>(in);
+        b[i] = interval(l, read_value<double>(in));
+    }
+    b.set_rank(read_value<double>(in));
+    b.set_depth(static_cast<unsigned>(read_value<uint64_t>(in)));
+}
+
+} // namespace detail
+
+#include "opt_openlist.hpp"
+#include "opt_compactlist.hpp"
+#include "opt_spilllist.hpp"
+
+// The objective and its derivatives are called through the types _func_p,
+// _func_d_p and _func_dd_p. The defaults erase the type of any callback in
+// a std::function, other callables such as lambdas can be inlined into the
+// tests of every box (see make_optimizer).
+template <size_t _size_p,
+    class _func_p = std::function<interval(const box<_size_p>&)>,
+    class _func_d_p = std::function<
+        typename box<_size_p>::vector_t(const box<_size_p>&)>,
+    class _func_dd_p = std::function<
+        detail::square_matrix<_size_p>(const box<_size_p>&)>>
 class optimizer {
 public:
-    using func_t = std::function<interval(const box<_size_p>& b)>;
-    using func_d_t = std::function<std::array<interval, _size_p>(const box<_size_p>& b)>;
-    using func_dd_t = std::function<Eigen::Matrix<interval, _size_p, _size_p>(const box<_size_p>& b)>;
+    // Types over boxes of the dimension of the problem, with _size_p set to
+    // dynamic the dimension is that of the box passed to solve
+    using point_t = typename box<_size_p>::point_t;
+    using vector_t = typename box<_size_p>::vector_t;
+    using matrix_t = detail::square_matrix<_size_p>;
+    using func_t = _func_p;
+    using func_d_t = _func_d_p;
+    using func_dd_t = _func_dd_p;
+    // Bounds the function over the boxes of a block, writing one interval
+    // per box to result. Slots past size() are padded up to the capacity,
+    // so packed evaluation may overrun size() to the next full register.
+    using func_batch_t = std::function<void(const box_block<_size_p>& b, interval* result)>;
+    // Bounds the orders set in flags over the box in one pass, sharing
+    // common subexpressions between them. Orders not requested must be left
+    // untouched in the result.
+    using func_eval_t = std::function<void(const box<_size_p>& b, unsigned flags, evaluation<_size_p>& result)>;
+    // Called every options_t::progress_boxes boxes, returns whether to
+    // continue the search
+    using func_progress_t = std::function<bool(const solve_progress& p)>;
+    // Bounds a constraint function over the box, points x with g(x) <= 0
+    // are feasible
+    using func_constraint_t = std::function<interval(const box<_size_p>& b)>;
+    // Bounds the gradient of a constraint over the box
+    using func_constraint_d_t = std::function<vector_t(const box<_size_p>& b)>;
 
     optimizer(const func_t& func, options_t opt = options_t())
     : func(func), options(opt) {}
+    optimizer(const func_t& func, const func_d_t& func_d,
+              options_t opt = options_t())
+    : func(func), func_d(func_d), options(opt) {}
+    optimizer(const func_t& func, const func_d_t& func_d,
+              const func_dd_t& func_dd, options_t opt = options_t())
+    : func(func), func_d(func_d), func_dd(func_dd), options(opt) {}
+
+    // Objective written for any scalar type (see is_objective). Its
+    // derivatives come from automatic differentiation as set in options.
+    template <class F, class = typename std::enable_if<
+        detail::is_fixed_objective<F, _size_p>::value>::type>
+    optimizer(const F& f, options_t opt = options_t()) : options(opt) {
+        func = [f](const box<_size_p>& b) { return f(b.coordinates()); };
+        if (opt.diff_mode == differentiation::REVERSE) {
+            set_tape(tape::record<_size_p>(f));
+            return;
+        }
+        func_eval = [f](const box<_size_p>& b, unsigned flags,
+                        evaluation<_size_p>& e) {
+            if (flags & EVALUATE_GRADIENT) {
+                dual<_size_p> r = f(variables(b));
+                if (flags & EVALUATE_VALUE) e.value = r.value();
+                e.gradient = r.gradient();
+            } else if (flags & EVALUATE_VALUE) {
+                e.value = f(b.coordinates());
+            }
+        };
+        eval_provides = EVALUATE_VALUE | EVALUATE_GRADIENT;
+    }
 
     void set_first_derivative(func_d_t f) { func_d = f; }
     void set_second_derivative(func_dd_t f) { func_dd = f; }
+    // Boxes are searched in blocks only once set. Per box the block search
+    // costs about as much as the scalar one, so it pays off with batch
+    // functions that evaluate several slots at once, as with packed types.
+    void set_batch_function(func_batch_t f) { func_batch = f; }
+    // Orders in provides are taken from f, the others still come from the
+    // separate callbacks
+    void set_combined_function(func_eval_t f, unsigned provides = EVALUATE_ALL) {
+        func_eval = f;
+        eval_provides = f ? provides : 0;
+    }
+    void set_progress_function(func_progress_t f) { func_progress = f; }
+    // Restricts the search to points where g is at most 0. Boxes where any
+    // constraint is certainly positive are rejected before the objective is
+    // evaluated, and only certainly feasible points become incumbents.
+    // Given the gradients of the objective and of the constraints that may
+    // be active, boxes not certainly feasible are tested for points of the
+    // Fritz John conditions instead of the monotonicity test.
+    void add_constraint(func_constraint_t g,
+                        func_constraint_d_t g_d = func_constraint_d_t()) {
+        constraints.push_back(g);
+        constraint_gradients.push_back(g_d);
+    }
+    // Restricts the search to points where h is 0, given its gradient h_d.
+    // As no midpoint is exactly feasible, an incumbent is the upper bound
+    // of the function over a small box around a candidate in which a
+    // feasible point is proved to exist by the Krawczyk test.
+    void add_equality_constraint(func_constraint_t h, func_constraint_d_t h_d) {
+        equalities.push_back(equality{h, h_d});
+    }
 
     box<_size_p> solve(const box<_size_p>& box0);
+    // Continues the search saved to path by a solve with
+    // options_t::checkpoint_file set, with the options saved along. Open
+    // boxes go to a spilling list given max_memory_boxes, else to a full
+    // one, also if they were stored compactly before.
+    box<_size_p> resume(const std::string& path);
 
     int64_t box_count() const { return num_boxes; }
-    double minimum() const { return f_min; }
+    double minimum() const { return f_min.load(std::memory_order_relaxed); }
     double time() const {return calc_time; }
+    const solve_statistics& statistics() const { return stats; }
+    // Why the last solve returned. Unless it is COMPLETE, the global
+    // minimum lies between lower_bound and minimum, and open_box_count
+    // boxes were left.
+    stop_reason stopped_by() const { return stopped; }
+    double lower_bound() const { return bound(f_open); }
+    size_t open_box_count() const { return num_open; }
 
 private:
+    // Preconditioned system of gauss_seidel, rhs and x_tilda are its input
+    struct gauss_seidel_workspace {
+        using double_matrix = detail::square_matrix<_size_p, double>;
+        using double_vector = detail::column_vector<_size_p, double>;
+        double_vector rhs;
+        point_t x_tilda;
+        double_matrix mid_matrix, C;
+        Eigen::PartialPivLU<double_matrix> lu;
+        matrix_t CA;
+        detail::column_vector<_size_p> Cb;
+        mid_rad_workspace<double_matrix, matrix_t> CA_product;
+        mid_rad_workspace<double_matrix, double_vector> Cb_product;
+    };
+
+    // Iterates of local_search and its inverse Hessian estimate
+    struct local_search_workspace {
+        using double_matrix = detail::square_matrix<_size_p, double>;
+        using double_vector = detail::column_vector<_size_p, double>;
+        double_vector x, x_next, g, g_next, d, s, y, Hy;
+        double_matrix H, A;
+        Eigen::LDLT<double_matrix> ldlt;
+        // Iterate as a box of points for the callbacks
+        box<_size_p> point;
+    };
+
+    // Newton iterates and Krawczyk operator of verify_feasible_box over the
+    // k equality constraints, sized on first use
+    struct equality_workspace {
+        // Coordinates solved for, the others stay at the candidate
+        std::vector<size_t> free;
+        // Midpoint Jacobian over all and over the free coordinates, and the
+        // approximate inverse of the latter
+        Eigen::MatrixXd jacobian, jacobian_free, inverse;
+        Eigen::FullPivLU<Eigen::MatrixXd> lu;
+        Eigen::VectorXd residual, step;
+        // Constraints at the last iterate and their gradients over the box
+        std::vector<interval> values;
+        std::vector<vector_t> gradients;
+        std::vector<interval> krawczyk;
+        // Last iterate, and the box proved to hold a feasible point
+        box<_size_p> point, feasible;
+    };
+
+    // Fritz John system over a box, linear in the multipliers of the
+    // objective, of the inequalities that may be active and of the
+    // equalities, and their domains
+    struct fritz_john_workspace {
+        // Gradients of the objective, the active inequalities and the
+        // equalities over the box
+        std::vector<vector_t> gradients;
+        Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> A, CA;
+        Eigen::MatrixXd mid_matrix, C;
+        std::vector<interval> multipliers;
+    };
+
+    struct constraint_cost {
+        double seconds = 0;
+        int64_t rejected = 0;
+    };
+
+    // Whether the constraints hold nowhere, somewhere or all over a box
+    enum class feasibility {INFEASIBLE, UNDECIDED, FEASIBLE};
+
+    // State owned by a single thread during solve. Buffers are sized once
+    // for the dimension n.
+    struct worker {
+        explicit worker(size_t n) {
+            detail::resize(solution, n);
+            detail::resize(gradient, n);
+            detail::resize(eval.gradient, n);
+            eval.hessian.resize(n, n);
+            detail::resize(center, n);
+            detail::resize(before, n);
+            gs.rhs.resize(n);
+            detail::resize(gs.x_tilda, n);
+            gs.mid_matrix.resize(n, n);
+            for (auto* v : {&local.x, &local.x_next, &local.g, &local.g_next,
+                            &local.d, &local.s, &local.y, &local.Hy}) {
+                v->resize(n);
+            }
+            local.H.resize(n, n);
+            local.A.resize(n, n);
+            detail::resize(local.point, n);
+            for (vector_t& g : gradients) {
+                detail::resize(g, n);
+            }
+        }
+
+        box<_size_p> solution;
+        double f_solution = INFINITY;
+        int64_t num_boxes = 0;
+        // Bisected boxes since the last local search
+        int64_t since_local_search = 0;
+        // Gradient over the last box passed to check_box
+        vector_t gradient;
+        // Result buffer of the evaluations of check_derivatives
+        evaluation<_size_p> eval;
+        // Midpoint of the current box, and the box before contraction
+        box<_size_p> center, before;
+        gauss_seidel_workspace gs;
+        local_search_workspace local;
+        equality_workspace equality;
+        // Seconds spent in and boxes rejected by each constraint, and the
+        // order they are checked in
+        std::vector<constraint_cost> constraint_costs;
+        std::vector<size_t> constraint_order;
+        int64_t constraint_checks = 0;
+        // Constraints over the last box checked, as numbered in costs
+        std::vector<interval> constraint_values;
+        fritz_john_workspace fritz_john;
+        // Scratch space of process_block
+        box_block<_size_p> block;
+        std::array<interval, box_block<_size_p>::capacity> bounds;
+        std::array<vector_t, box_block<_size_p>::capacity> gradients;
+        solve_statistics stats;
+    };
+
     func_t func;
     func_d_t func_d;
     func_dd_t func_dd;
+    func_batch_t func_batch;
+    func_eval_t func_eval;
+    func_progress_t func_progress;
+    std::vector<func_constraint_t> constraints;
+    std::vector<func_constraint_d_t> constraint_gradients;
+    struct equality {
+        func_constraint_t h;
+        func_constraint_d_t h_d;
+    };
+    std::vector<equality> equalities;
+    unsigned eval_provides = 0;
     options_t options;
     box<_size_p> box0;
 
-    double f_min = INFINITY;
+    // Shared between threads, only ever lowered
+    detail::shared_double f_min{INFINITY};
     int64_t num_boxes = 0;
     double calc_time = 0; // in seconds
+    std::chrono::high_resolution_clock::time_point start_time;
+    solve_statistics stats;
+    // Lowest bound of the function over boxes closed within tolerance,
+    // shared between threads, and over the boxes left open
+    detail::shared_double f_closed{INFINITY};
+    double f_open = INFINITY;
+    size_t num_open = 0;
+    stop_reason stopped = stop_reason::COMPLETE;
 
-    std::array<box<_size_p>, 2> bisection(const box<_size_p>& b) const;
-    int check_box(box<_size_p>& b);
+    // Splits b into list, taking its storage
+    template <class list_t>
+    void bisection(box<_size_p>& b, const vector_t& f_d, list_t& list) const;
+    size_t split_coordinate(const box<_size_p>& b, const vector_t& f_d) const;
+    bool has_gradient() const {
+        return detail::is_set(func_d) || (eval_provides & EVALUATE_GRADIENT);
+    }
+    bool has_hessian() const {
+        return detail::is_set(func_dd) || (eval_provides & EVALUATE_HESSIAN);
+    }
+    void evaluate(const box<_size_p>& b, unsigned flags, worker& w);
+    // Timer target of a statistic, none unless statistics are collected
+    double* timed(double& seconds) const {
+        return this->options.collect_statistics ? &seconds : nullptr;
+    }
+    int check_derivatives(box<_size_p>& b, vector_t& f_d, worker& w,
+                          unsigned flags = 0, bool is_feasible = true);
+    feasibility check_constraints(const box<_size_p>& b, worker& w);
+    int fritz_john(const box<_size_p>& b, const vector_t& f_d, worker& w);
+    bool has_no_multipliers(fritz_john_workspace& fj, size_t n,
+                            size_t num_equalities, unsigned signs) const;
+    bool is_feasible_point(const box<_size_p>& m, worker& w) const;
+    bool verify_feasible_box(const box<_size_p>& m, worker& w);
+    void equality_newton_step(worker& w, bool choose_free);
+    int check_box(box<_size_p>& b, worker& w);
+    void record_contraction(const box<_size_p>& b, worker& w) const;
+    bool wants_local_search(worker& w, bool is_improved) const;
+    void local_search(const box<_size_p>& b, worker& w);
+    void seed_incumbent(const box<_size_p>& box0, std::vector<worker>& workers);
+    void seed_range(const box<_size_p>& box0, const std::vector<unsigned>& bases,
+                    int64_t begin, int64_t end, worker& w);
+    template <class V>
+    double point_value(const V& x, worker& w);
+    template <class V>
+    void point_gradient(const V& x, V& g, worker& w);
     int gauss_seidel(
-        const Eigen::Matrix<interval, _size_p, _size_p>& A,
-        const std::array<double, _size_p>& b,
-        box<_size_p> &x,
-        const std::array<double, _size_p>& x_tilda) const;
+        const matrix_t& A, box<_size_p> &x, gauss_seidel_workspace& ws) const;
+
+    template <class list_t>
+    void search(list_t& list, worker& w);
+    template <class list_t>
+    void save_checkpoint(list_t& list, const worker& w) const;
+    box<_size_p> collect(std::vector<worker>& workers);
+    template <class list_t>
+    void process_box(box<_size_p>& b, worker& w, list_t& children);
+    template <class list_t>
+    void process_block(
+        std::vector<box<_size_p>>& boxes, worker& w, list_t& children);
+    bool update_minimum(
+        worker& w, const box<_size_p>& m, double f, bool accept_equal);
+    void close_box(const box<_size_p>& b);
+    stop_reason limit_reached(int64_t boxes, size_t open, size_t n) const;
+    bool report_progress(int64_t boxes, size_t open, double f_open_boxes) const;
+    // Lower bound of the global minimum given that of the open boxes
+    double bound(double f_open_boxes) const;
+    void solve_parallel(const box<_size_p>& box0, std::vector<worker>& workers);
+    void set_tape(const tape& t);
 };
 
 #include "opt_checkbox.hpp"
 #include "opt_bisection.hpp"
 #include "opt_algorithm.hpp"
+#include "opt_batch.hpp"
+#include "opt_parallel.hpp"
 #include "opt_gaussseidel.hpp"
+#include "opt_tape.hpp"
+#include "opt_checkpoint.hpp"
+#include "opt_localsearch.hpp"
+#include "opt_seeding.hpp"
+#include "opt_constraints.hpp"
+#include "opt_fritzjohn.hpp"
+
+// Optimizer calling the given callables directly, e.g.
+//     auto opt = make_optimizer<2>(
+//         [](const box<2>& b) { return sqr(b[0]) + sqr(b[1]); });
+// Derivatives not given are left out of the tests.
+template <size_t _size_p, class F>
+inline optimizer<_size_p, F,
+    detail::no_function<typename box<_size_p>::vector_t>,
+    detail::no_function<detail::square_matrix<_size_p>>>
+make_optimizer(F f, options_t opt = options_t()) {
+    return {f, opt};
+}
+
+template <size_t _size_p, class F, class G>
+inline optimizer<_size_p, F, G,
+    detail::no_function<detail::square_matrix<_size_p>>>
+make_optimizer(F f, G g, options_t opt = options_t()) {
+    return {f, g, opt};
+}
+
+template <size_t _size_p, class F, class G, class H>
+inline optimizer<_size_p, F, G, H>
+make_optimizer(F f, G g, H h, options_t opt = options_t()) {
+    return {f, g, h, opt};
+}
 
 } // namespace rapidlab
 
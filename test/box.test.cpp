@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/box.hpp"
+#include "interval/box_block.hpp"
+
+#include <thread>
+#include <vector>
+
+using namespace rapidlab;
+using namespace testing;
+
+class ADynamicBox : public Test {
+public:
+    box<dynamic> b{interval(0, 2), interval(-1, 1), interval(3, 7)};
+
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+    }
+};
+
+TEST_F(ADynamicBox, hasTheDimensionOfItsCoordinates) {
+    EXPECT_THAT(b.size(), Eq(3u));
+    EXPECT_THAT(b[2], Eq(interval(3, 7)));
+    EXPECT_THAT(box<dynamic>(std::vector<double>(5, 1.0)).size(), Eq(5u));
+}
+
+TEST_F(ADynamicBox, copiesCoordinatesRankAndDepth) {
+    b.set_rank(4);
+    b.set_depth(2);
+    box<dynamic> c(b);
+    c[0] = interval(1);
+
+    EXPECT_THAT(c.size(), Eq(3u));
+    EXPECT_THAT(c[1], Eq(b[1]));
+    EXPECT_THAT(b[0], Eq(interval(0, 2)));
+    EXPECT_THAT(c.get_rank(), Eq(4));
+    EXPECT_THAT(c.get_depth(), Eq(2u));
+}
+
+TEST_F(ADynamicBox, takesStorageOfMovedBox) {
+    const interval* data = b.begin();
+    box<dynamic> c(std::move(b));
+    EXPECT_THAT(c.begin(), Eq(data));
+    EXPECT_THAT(b.size(), Eq(0u));
+}
+
+TEST_F(ADynamicBox, reusesStorageOfReleasedBoxesOfSameDimension) {
+    const interval* data;
+    {
+        box<dynamic> c(b);
+        data = c.begin();
+    }
+    box<dynamic> d(b);
+    EXPECT_THAT(d.begin(), Eq(data));
+}
+
+TEST_F(ADynamicBox, releasesStorageToHeapAfterPoolOfItsThreadIsGone) {
+    std::thread t([] {
+        // Constructed before the pool, so destroyed after it
+        thread_local box<dynamic> late;
+        { box<dynamic> c(4); }
+        late = box<dynamic>(4);
+        EXPECT_THAT(late.size(), Eq(4u));
+    });
+    t.join();
+}
+
+TEST_F(ADynamicBox, keepsStorageWhenAssignedBoxOfSameDimension) {
+    box<dynamic> c(3);
+    const interval* data = c.begin();
+    c = b;
+    EXPECT_THAT(c.begin(), Eq(data));
+    EXPECT_THAT(c[2], Eq(interval(3, 7)));
+}
+
+TEST_F(ADynamicBox, givesMidpointAndDiameter) {
+    std::vector<double> m = mid(b);
+    std::vector<double> d = diam(b);
+    EXPECT_THAT(m, ElementsAre(1, 0, 5));
+    EXPECT_THAT(d, ElementsAre(2, 2, 4));
+
+    box<dynamic> c;
+    mid(b, c);
+    EXPECT_THAT(c[2], Eq(interval(5)));
+}
+
+TEST_F(ADynamicBox, isStoredCoordinateByCoordinateInABlock) {
+    box_block<dynamic> block;
+    block.push_back(b);
+    block.pad();
+    EXPECT_THAT(block[2][block.capacity - 1], Eq(interval(3, 7)));
+    EXPECT_THAT(block.get(0)[1], Eq(interval(-1, 1)));
+}
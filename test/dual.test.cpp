@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/dual.hpp"
+
+using namespace rapidlab;
+using namespace testing;
+
+class ADual : public Test {
+public:
+    box<2> b;
+    std::array<dual<2>, 2> x;
+
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+        b = box<2>({interval(1, 2), interval(-3, -1)});
+        x = variables(b);
+    }
+};
+
+struct rosenbrock {
+    template<class T>
+    T operator()(const std::array<T, 2>& x) const {
+        return 100 * sqr(x[1] - sqr(x[0])) + sqr(x[0] - 1);
+    }
+};
+
+TEST_F(ADual, hasUnitGradientForVariables) {
+    EXPECT_THAT(x[0].value(), Eq(b[0]));
+    EXPECT_THAT(x[0][0], Eq(interval(1)));
+    EXPECT_THAT(x[0][1], Eq(interval(0)));
+    EXPECT_THAT(x[1][0], Eq(interval(0)));
+    EXPECT_THAT(x[1][1], Eq(interval(1)));
+}
+
+TEST_F(ADual, hasZeroGradientForConstants) {
+    dual<2> c(interval(2, 3));
+    EXPECT_THAT(c.value(), Eq(interval(2, 3)));
+    EXPECT_THAT(c[0], Eq(interval(0)));
+    EXPECT_THAT(c[1], Eq(interval(0)));
+}
+
+TEST_F(ADual, differentiatesSumsAndDifferences) {
+    dual<2> r = 3 * x[0] - x[1] + 2;
+    EXPECT_THAT(r.value(), Eq(3 * b[0] - b[1] + 2));
+    EXPECT_THAT(r[0], Eq(interval(3)));
+    EXPECT_THAT(r[1], Eq(interval(-1)));
+}
+
+TEST_F(ADual, differentiatesProductsAndQuotients) {
+    dual<2> p = x[0] * x[1];
+    EXPECT_THAT(p.value(), Eq(b[0] * b[1]));
+    EXPECT_THAT(p[0], Eq(b[1]));
+    EXPECT_THAT(p[1], Eq(b[0]));
+
+    dual<2> q = x[0] / x[1];
+    EXPECT_THAT(q.value(), Eq(b[0] / b[1]));
+    // d/dx1 (x0/x1) = -x0/x1^2
+    EXPECT_THAT(contains(q[1], -1 / sqr(interval(-1.5))), Eq(true));
+    EXPECT_THAT(contains(q[0], 1 / interval(-2)), Eq(true));
+}
+
+TEST_F(ADual, differentiatesElementaryFunctions) {
+    dual<2> s = sqr(x[1]);
+    EXPECT_THAT(s.value(), Eq(interval(1, 9)));
+    EXPECT_THAT(s[1], Eq(interval(-6, -2)));
+
+    dual<2> r = sqrt(x[0]);
+    EXPECT_THAT(contains(r[0], 0.5 / std::sqrt(1.5)), Eq(true));
+
+    dual<2> a = abs(x[1]);
+    EXPECT_THAT(a.value(), Eq(interval(1, 3)));
+    EXPECT_THAT(a[1], Eq(interval(-1)));
+
+    dual<2> e = exp(x[0]);
+    EXPECT_THAT(e[0], Eq(e.value()));
+
+    dual<2> l = log(x[0]);
+    EXPECT_THAT(l[0], Eq(1.0 / b[0]));
+
+    dual<2> c = cos(x[0]);
+    EXPECT_THAT(contains(c[0], -std::sin(1.5)), Eq(true));
+    dual<2> t = sin(x[0]);
+    EXPECT_THAT(contains(t[0], std::cos(1.5)), Eq(true));
+}
+
+TEST_F(ADual, enclosesGradientOfGenericObjective) {
+    rosenbrock f;
+    dual<2> r = f(x);
+    EXPECT_THAT(r.value(), Eq(f(b.coordinates())));
+    // Hand-written derivative
+    interval d1 = 200 * (b[1] - sqr(b[0]));
+    interval d0 = -400 * b[0] * (b[1] - sqr(b[0])) + 2 * (b[0] - 1);
+    EXPECT_THAT(contains(r[0], d0), Eq(true));
+    EXPECT_THAT(contains(r[1], d1), Eq(true));
+    EXPECT_THAT(diam(r[1]), DoubleEq(diam(d1)));
+}
+
+TEST_F(ADual, detectsGenericObjectives) {
+    EXPECT_THAT((is_objective<rosenbrock, 2>::value), Eq(true));
+    EXPECT_THAT((is_objective<interval(*)(const box<2>&), 2>::value), Eq(false));
+}
@@ -0,0 +1,309 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/eigen_support.hpp"
+
+#include <random>
+
+using namespace rapidlab;
+using namespace testing;
+
+class AMidRadProduct : public Test {
+public:
+    // Size of the Hessians the Gauss-Seidel step preconditions
+    static const int n = 50;
+    typedef Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> imatrix;
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> dmatrix;
+
+    std::mt19937 generator;
+
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+        generator.seed(42);
+    }
+
+    // Integer bounds keep products of vertices exact
+    imatrix integerIntervals(int rows, int cols) {
+        std::uniform_int_distribution<int> lower(-8, 8), width(0, 3);
+        imatrix a(rows, cols);
+        for (int j = 0; j < cols; ++j) {
+            for (int i = 0; i < rows; ++i) {
+                double l = lower(generator);
+                a(i, j) = interval(l, l + width(generator));
+            }
+        }
+        return a;
+    }
+
+    imatrix realIntervals(int rows, int cols) {
+        std::uniform_real_distribution<double> lower(-1, 1), width(0, 0.1);
+        imatrix a(rows, cols);
+        for (int j = 0; j < cols; ++j) {
+            for (int i = 0; i < rows; ++i) {
+                double l = lower(generator);
+                a(i, j) = interval(l, l + width(generator));
+            }
+        }
+        return a;
+    }
+
+    // Random choice of a bound for each entry
+    dmatrix vertex(const imatrix& a) {
+        std::bernoulli_distribution upper;
+        dmatrix v(a.rows(), a.cols());
+        for (int j = 0; j < a.cols(); ++j) {
+            for (int i = 0; i < a.rows(); ++i) {
+                v(i, j) = upper(generator) ? a(i, j).upper() : a(i, j).lower();
+            }
+        }
+        return v;
+    }
+
+    imatrix entrywiseProduct(const imatrix& a, const imatrix& b) {
+        imatrix c(a.rows(), b.cols());
+        for (int j = 0; j < b.cols(); ++j) {
+            for (int i = 0; i < a.rows(); ++i) {
+                interval s(0);
+                for (int k = 0; k < a.cols(); ++k) {
+                    s += a(i, k) * b(k, j);
+                }
+                c(i, j) = s;
+            }
+        }
+        return c;
+    }
+
+    void expectContains(const imatrix& c, const dmatrix& p) {
+        for (int j = 0; j < c.cols(); ++j) {
+            for (int i = 0; i < c.rows(); ++i) {
+                EXPECT_THAT(c(i, j).lower(), Le(p(i, j))) << i << "," << j;
+                EXPECT_THAT(c(i, j).upper(), Ge(p(i, j))) << i << "," << j;
+            }
+        }
+    }
+};
+
+TEST_F(AMidRadProduct, containsProductsOfIntervalMatrices) {
+    imatrix a = integerIntervals(n, n), b = integerIntervals(n, n);
+    imatrix c = mid_rad_product(a, b);
+    for (int k = 0; k < 5; ++k) {
+        // Products of integer vertices are computed exactly
+        dmatrix va = vertex(a), vb = vertex(b);
+        expectContains(c, dmatrix(va * vb));
+    }
+}
+
+TEST_F(AMidRadProduct, containsProductsOfPointAndIntervalMatrices) {
+    std::uniform_int_distribution<int> entry(-8, 8);
+    dmatrix p(n, n);
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) p(i, j) = entry(generator);
+    }
+    imatrix a = integerIntervals(n, n);
+    imatrix left = mid_rad_product(p, a);
+    imatrix right = mid_rad_product(a, p);
+    for (int k = 0; k < 5; ++k) {
+        dmatrix va = vertex(a);
+        expectContains(left, dmatrix(p * va));
+        expectContains(right, dmatrix(va * p));
+    }
+}
+
+TEST_F(AMidRadProduct, containsProductsOfSmallMatricesOfDynamicSize) {
+    // Sizes below the GEMM threshold are summed entry by entry
+    for (int m = 1; m <= 6; ++m) {
+        imatrix a = integerIntervals(m, m), b = integerIntervals(m, 1);
+        imatrix c = mid_rad_product(a, b);
+        ASSERT_THAT(c.rows(), Eq(m));
+        ASSERT_THAT(c.cols(), Eq(1));
+        for (int k = 0; k < 5; ++k) {
+            dmatrix va = vertex(a), vb = vertex(b);
+            expectContains(c, dmatrix(va * vb));
+        }
+    }
+}
+
+TEST_F(AMidRadProduct, isAtMostOneAndAHalfTimesWiderThanEntrywiseProduct) {
+    imatrix a = realIntervals(n, n), b = realIntervals(n, n);
+    imatrix c = mid_rad_product(a, b);
+    imatrix e = entrywiseProduct(a, b);
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            EXPECT_THAT(diam(c(i, j)), Le(1.5 * diam(e(i, j)) + 1e-12));
+        }
+    }
+}
+
+TEST_F(AMidRadProduct, multipliesPointMatrixByVectorTightly) {
+    std::uniform_int_distribution<int> entry(-8, 8);
+    Eigen::Matrix<double, n, n> p;
+    Eigen::Matrix<double, n, 1> v;
+    for (int j = 0; j < n; ++j) {
+        v(j) = entry(generator);
+        for (int i = 0; i < n; ++i) p(i, j) = entry(generator);
+    }
+    Eigen::Matrix<interval, n, 1> c = mid_rad_product(p, v);
+    Eigen::Matrix<double, n, 1> exact = p * v;
+    for (int i = 0; i < n; ++i) {
+        EXPECT_THAT(c(i).lower(), Le(exact(i)));
+        EXPECT_THAT(c(i).upper(), Ge(exact(i)));
+        EXPECT_THAT(diam(c(i)), Lt(1e-10));
+    }
+}
+
+TEST_F(AMidRadProduct, fallsBackToEntrywiseProductForUnboundedEntries) {
+    imatrix a = integerIntervals(3, 3), b = integerIntervals(3, 3);
+    a(1, 2) = interval(-INFINITY, 1);
+    // Zero times infinity has no bound
+    b.row(2).setConstant(interval(1, 2));
+    imatrix c = mid_rad_product(a, b);
+    imatrix e = entrywiseProduct(a, b);
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_THAT(c(i, j), Eq(e(i, j)));
+        }
+    }
+}
+
+TEST_F(AMidRadProduct, givesSameBoundsFromThreadRoundingToNearest) {
+    imatrix a = realIntervals(n, n), b = realIntervals(n, n);
+    imatrix up = mid_rad_product(a, b);
+    imatrix nearest;
+    {
+        rounding_guard<rounding::nearest> guard;
+        nearest = mid_rad_product(a, b);
+        EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_NEAREST));
+    }
+    EXPECT_THAT(nearest == up, Eq(true));
+}
+
+class AnIntervalMatrix : public Test {
+public:
+    // Odd size leaves a coefficient past the last full packet
+    static const int n = 7;
+    typedef Eigen::Matrix<interval, n, n> imatrix;
+    typedef Eigen::Matrix<interval, n, 1> ivector;
+
+    imatrix a, b;
+    ivector v;
+
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+        for (int j = 0; j < n; ++j) {
+            v(j) = interval(j - 3, j + 1);
+            for (int i = 0; i < n; ++i) {
+                // Integer bounds keep sums and products exact in any order
+                a(i, j) = interval(i - j, i + 2);
+                b(i, j) = interval(j + 1, i + j + 2);
+            }
+        }
+    }
+
+    template<class F>
+    void expectCoefficientwise(const imatrix& r, F f) {
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                EXPECT_THAT(r(i, j), Eq(f(a(i, j), b(i, j)))) << i << "," << j;
+            }
+        }
+    }
+};
+
+TEST_F(AnIntervalMatrix, addsCoefficientwise) {
+    imatrix r = a + b;
+    expectCoefficientwise(r, [](const interval& x, const interval& y) {
+        return x + y;
+    });
+}
+
+TEST_F(AnIntervalMatrix, subtractsCoefficientwise) {
+    imatrix r = a - b;
+    expectCoefficientwise(r, [](const interval& x, const interval& y) {
+        return x - y;
+    });
+}
+
+TEST_F(AnIntervalMatrix, multipliesAndDividesCoefficientwise) {
+    imatrix r = a.cwiseProduct(b);
+    expectCoefficientwise(r, [](const interval& x, const interval& y) {
+        return x * y;
+    });
+    r = a.cwiseQuotient(b);
+    expectCoefficientwise(r, [](const interval& x, const interval& y) {
+        return x / y;
+    });
+}
+
+TEST_F(AnIntervalMatrix, negatesAndTakesAbsoluteValueAndSquareRoot) {
+    imatrix r = -a;
+    expectCoefficientwise(r, [](const interval& x, const interval&) {
+        return -x;
+    });
+    r = a.cwiseAbs();
+    expectCoefficientwise(r, [](const interval& x, const interval&) {
+        return abs(x);
+    });
+    r = b.cwiseSqrt();
+    expectCoefficientwise(r, [](const interval&, const interval& y) {
+        return sqrt(y);
+    });
+}
+
+TEST_F(AnIntervalMatrix, reducesToSum) {
+    interval s(0);
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) s += a(i, j);
+    }
+    EXPECT_THAT(a.sum(), Eq(s));
+}
+
+TEST_F(AnIntervalMatrix, multipliesMatrixByVector) {
+    ivector r = a * v;
+    ivector t = a.transpose() * v;
+    for (int i = 0; i < n; ++i) {
+        interval s(0), st(0);
+        for (int j = 0; j < n; ++j) {
+            s += a(i, j) * v(j);
+            st += a(j, i) * v(j);
+        }
+        EXPECT_THAT(r(i), Eq(s)) << i;
+        EXPECT_THAT(t(i), Eq(st)) << i;
+    }
+}
+
+TEST_F(AnIntervalMatrix, multipliesMatrices) {
+    Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> x = a, y = b;
+    Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> r = x * y;
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            interval s(0);
+            for (int k = 0; k < n; ++k) s += a(i, k) * b(k, j);
+            EXPECT_THAT(r(i, j), Eq(s)) << i << "," << j;
+        }
+    }
+}
+
+TEST_F(AnIntervalMatrix, multipliesMatricesWithOddStrideByVector) {
+    // Columns alternate between aligned and unaligned starts
+    const int m = 51;
+    Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> x(m, m);
+    Eigen::Matrix<interval, Eigen::Dynamic, 1> y(m);
+    for (int j = 0; j < m; ++j) {
+        y(j) = interval(j % 5 - 2, j % 5);
+        for (int i = 0; i < m; ++i) x(i, j) = interval(i % 7 - j % 3, i % 7 + 1);
+    }
+    Eigen::Matrix<interval, Eigen::Dynamic, 1> r = x * y;
+    Eigen::Matrix<interval, Eigen::Dynamic, 1> t = x.transpose() * y;
+    for (int i = 0; i < m; ++i) {
+        interval s(0), st(0);
+        for (int j = 0; j < m; ++j) {
+            s += x(i, j) * y(j);
+            st += x(j, i) * y(j);
+        }
+        EXPECT_THAT(r(i), Eq(s)) << i;
+        EXPECT_THAT(t(i), Eq(st)) << i;
+    }
+}
@@ -508,3 +508,46 @@ TEST_F(AnInterval, hasIntersection) {
     EXPECT_THAT(std::isnan(f.lower()), Eq(true));
     EXPECT_THAT(std::isnan(f.upper()), Eq(true));
 }
+
+TEST_F(AnInterval, hasExponential) {
+    interval a(-1, 2);
+    interval b = exp(a);
+    EXPECT_THAT(b.lower(), Le(std::exp(-1.0)));
+    EXPECT_THAT(b.upper(), Ge(std::exp(2.0)));
+    EXPECT_THAT(b.lower(), Gt(std::exp(-1.0) - 1e-15));
+    EXPECT_THAT(b.upper(), Lt(std::exp(2.0) + 1e-14));
+    EXPECT_THAT(exp(interval(-1000, 0)).lower(), Eq(0));
+}
+
+TEST_F(AnInterval, hasLogarithm) {
+    interval a(1, 8);
+    interval b = log(a);
+    EXPECT_THAT(b.lower(), Le(0));
+    EXPECT_THAT(b.upper(), Ge(std::log(8.0)));
+    EXPECT_THAT(b.upper(), Lt(std::log(8.0) + 1e-14));
+    EXPECT_THAT(log(interval(-1, 1)).lower(), Eq(-INFINITY));
+    EXPECT_THAT(std::isnan(log(interval(-2, -1)).upper()), Eq(true));
+}
+
+TEST_F(AnInterval, reducesModuloTwicePiRoundingUp) {
+    const interval pi2 = pi_twice();
+    for (double x = -20; x < 20; x += 0.7) {
+        interval a(x, x + 0.5);
+        interval m = fmod(a, pi2);
+        //quotient rounded up in -(l / 2pi), the remainder starts in [0, 2pi)
+        EXPECT_THAT(m.lower(), AllOf(Ge(-1e-12), Lt(pi2.upper()))) << x;
+        EXPECT_THAT(diam(m), Lt(0.5 + 1e-12)) << x;
+    }
+}
+
+TEST_F(AnInterval, hasCosineAndSine) {
+    for (double x = -20; x < 20; x += 0.7) {
+        interval a(x, x + 0.5);
+        interval c = cos(a);
+        interval s = sin(a);
+        EXPECT_THAT(std::cos(x), AllOf(Ge(c.lower()), Le(c.upper()))) << x;
+        EXPECT_THAT(std::cos(x + 0.5), AllOf(Ge(c.lower()), Le(c.upper()))) << x;
+        EXPECT_THAT(std::sin(x), AllOf(Ge(s.lower()), Le(s.upper()))) << x;
+        EXPECT_THAT(diam(c), Le(0.5 + 1e-12)) << x;
+    }
+}
@@ -0,0 +1,235 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/interval_array.hpp"
+
+using namespace rapidlab;
+using namespace testing;
+
+class AnIntervalArray : public Test {
+public:
+    // Size not a multiple of the register width to cover the padding
+    static const size_t n = 7;
+    interval_array a;
+    interval_array b;
+
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+        const interval va[n] = {interval(0.1, 4.1), interval(-4.1, -0.1),
+                                interval(-4.1, 0.1), interval(2, 3),
+                                interval(0.3, 0.7), interval(-1, 1),
+                                interval(5)};
+        const interval vb[n] = {interval(-3, -2), interval(0.3, 1.7),
+                                interval(-0.2, 5), interval(-1, 0.5),
+                                interval(1, 2), interval(2, 3),
+                                interval(-0.5, -0.25)};
+        a = interval_array(n);
+        b = interval_array(n);
+        for (size_t i = 0; i < n; ++i) {
+            a.set(i, va[i]);
+            b.set(i, vb[i]);
+        }
+    }
+
+    // Every element must equal the scalar result bit by bit
+    template <class F>
+    void expectEqualToScalar(const interval_array& r, F f) {
+        ASSERT_THAT(r.size(), Eq(n));
+        for (size_t i = 0; i < n; ++i) {
+            const interval e = f(a[i], b[i]);
+            if (std::isnan(e.lower())) {
+                EXPECT_THAT(std::isnan(r.lower(i)), Eq(true)) << i;
+                continue;
+            }
+            EXPECT_THAT(r.lower(i), DoubleEq(e.lower())) << i;
+            EXPECT_THAT(r.upper(i), DoubleEq(e.upper())) << i;
+        }
+    }
+
+    // Every element must enclose g at points throughout the interval, and
+    // differ from the scalar result f only by the error bounds of the
+    // polynomial kernels
+    template <class F, class G>
+    void expectCloseToScalar(const interval_array& r, const interval_array& x,
+                             F f, G g) {
+        ASSERT_THAT(r.size(), Eq(n));
+        for (size_t i = 0; i < n; ++i) {
+            const interval e = f(x[i]);
+            if (std::isnan(e.upper())) {
+                EXPECT_THAT(std::isnan(r.lower(i)), Eq(true)) << i;
+                EXPECT_THAT(std::isnan(r.upper(i)), Eq(true)) << i;
+                continue;
+            }
+            expectClose(r.lower(i), e.lower(), i);
+            expectClose(r.upper(i), e.upper(), i);
+
+            //library functions are accurate rounding to nearest
+            rounding_guard<rounding::nearest> nearest;
+            for (int k = 0; k <= 100; ++k) {
+                const double t = std::min(x.upper(i),
+                    x.lower(i) + (x.upper(i) - x.lower(i)) * k / 100);
+                const double v = g(t);
+                if (std::isnan(v)) continue;
+                EXPECT_THAT(v, AllOf(Ge(r.lower(i)), Le(r.upper(i))))
+                    << i << " at " << t;
+            }
+        }
+    }
+
+    static void expectClose(double r, double e, size_t i) {
+        if (std::isinf(e)) {
+            EXPECT_THAT(r, Eq(e)) << i;
+        } else {
+            EXPECT_THAT(r, DoubleNear(e, 1e-13 * std::max(1.0, std::fabs(e))))
+                << i;
+        }
+    }
+
+    static interval add(const interval& x, const interval& y) { return x + y; }
+    static interval sub(const interval& x, const interval& y) { return x - y; }
+    static interval mul(const interval& x, const interval& y) { return x * y; }
+    static interval div(const interval& x, const interval& y) { return x / y; }
+    static interval square(const interval& x, const interval&) { return sqr(x); }
+    static interval root(const interval& x, const interval&) { return sqrt(x); }
+};
+
+const size_t AnIntervalArray::n;
+
+TEST_F(AnIntervalArray, storesIntervals) {
+    interval_array c(n, interval(1, 2));
+    EXPECT_THAT(c.size(), Eq(n));
+    EXPECT_THAT(c[n-1], Eq(interval(1, 2)));
+    EXPECT_THAT(a[3], Eq(interval(2, 3)));
+    EXPECT_THAT(reinterpret_cast<uintptr_t>(a.upper_data()) % 32, Eq(0u));
+    EXPECT_THAT(a.padded() % interval_array::s::lanes, Eq(0u));
+}
+
+TEST_F(AnIntervalArray, copiesIntervals) {
+    interval_array c = a;
+    c.set(0, interval(7));
+    EXPECT_THAT(c[1], Eq(a[1]));
+    EXPECT_THAT(a[0], Eq(interval(0.1, 4.1)));
+}
+
+TEST_F(AnIntervalArray, addsElementwise) {
+    expectEqualToScalar(a + b, add);
+}
+
+TEST_F(AnIntervalArray, subtractsElementwise) {
+    expectEqualToScalar(a - b, sub);
+}
+
+TEST_F(AnIntervalArray, multipliesElementwise) {
+    expectEqualToScalar(a * b, mul);
+}
+
+TEST_F(AnIntervalArray, dividesElementwise) {
+    expectEqualToScalar(a / b, div);
+}
+
+TEST_F(AnIntervalArray, squaresElementwise) {
+    expectEqualToScalar(sqr(a), square);
+}
+
+TEST_F(AnIntervalArray, takesSquareRootElementwise) {
+    expectEqualToScalar(sqrt(a), root);
+}
+
+TEST_F(AnIntervalArray, combinesWithScalarInterval) {
+    interval s(-1, 2);
+    interval_array c = a * s;
+    interval_array d = s - b;
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_THAT(c[i], Eq(a[i] * s)) << i;
+        EXPECT_THAT(d[i], Eq(s - b[i])) << i;
+    }
+}
+
+TEST_F(AnIntervalArray, enclosesExponentialAndLogarithm) {
+    expectCloseToScalar(exp(a), a, [](const interval& x) { return exp(x); },
+                        [](double t) { return std::exp(t); });
+    expectCloseToScalar(log(b), b, [](const interval& x) { return log(x); },
+                        [](double t) { return std::log(t); });
+    expectCloseToScalar(log(exp(a)), exp(a),
+                        [](const interval& x) { return log(x); },
+                        [](double t) { return std::log(t); });
+}
+
+TEST_F(AnIntervalArray, boundsExponentialAndLogarithmAtTheirLimits) {
+    interval_array x(5);
+    x.set(0, interval(-800, -750));
+    x.set(1, interval(700, 800));
+    x.set(2, interval(0, INFINITY));
+    x.set(3, interval(1e-310, 1e-300));
+    x.set(4, interval(0));
+    interval_array e = exp(x);
+    EXPECT_THAT(e.lower(0), Eq(0));
+    EXPECT_THAT(e.upper(0), AllOf(Gt(0), Lt(1e-300)));
+    EXPECT_THAT(e.upper(1), Eq(INFINITY));
+    EXPECT_THAT(e.upper(2), Eq(INFINITY));
+    EXPECT_THAT(contains(e[4], interval(1)), Eq(true));
+    EXPECT_THAT(contains(interval(1 - 1e-13, 1 + 1e-13), e[4]), Eq(true));
+
+    interval_array l = log(x);
+    EXPECT_THAT(l.lower(2), Eq(-INFINITY));
+    EXPECT_THAT(l.upper(2), Eq(INFINITY));
+    EXPECT_THAT(l.lower(3), DoubleNear(std::log(1e-310), 1e-10));
+    EXPECT_THAT(l.upper(3), DoubleNear(std::log(1e-300), 1e-10));
+    EXPECT_THAT(l.lower(3), Le(std::log(1e-310)));
+}
+
+TEST_F(AnIntervalArray, enclosesTrigonometricFunctions) {
+    interval_array c = cos(a);
+    interval_array s = sin(a);
+    expectCloseToScalar(c, a, [](const interval& x) { return cos(x); },
+                        [](double t) { return std::cos(t); });
+    expectCloseToScalar(s, a, [](const interval& x) { return sin(x); },
+                        [](double t) { return std::sin(t); });
+    //extrema inside the intervals
+    EXPECT_THAT(c.lower(0), Eq(-1));
+    EXPECT_THAT(c.upper(5), Eq(1));
+    EXPECT_THAT(s.upper(0), Eq(1));
+    EXPECT_THAT(s.lower(1), Eq(-1));
+}
+
+TEST_F(AnIntervalArray, enclosesTrigonometricFunctionsOverManyPeriods) {
+    const size_t m = 64;
+    interval_array x(m);
+    for (size_t i = 0; i < m; ++i) {
+        const double l = -100 + 3.3 * i;
+        x.set(i, interval(l, l + 0.05 * (i % 7) + 0.01));
+    }
+    interval_array c = cos(x);
+    interval_array s = sin(x);
+    for (size_t i = 0; i < m; ++i) {
+        rounding_guard<rounding::nearest> nearest;
+        for (int k = 0; k <= 20; ++k) {
+            const double t = std::min(x.upper(i),
+                x.lower(i) + (x.upper(i) - x.lower(i)) * k / 20);
+            EXPECT_THAT(std::cos(t), AllOf(Ge(c.lower(i)), Le(c.upper(i))))
+                << i;
+            EXPECT_THAT(std::sin(t), AllOf(Ge(s.lower(i)), Le(s.upper(i))))
+                << i;
+        }
+        EXPECT_THAT(diam(c[i]), Le(0.05 * (i % 7) + 0.01 + 1e-12)) << i;
+    }
+    interval_array wide(1, interval(1e7, 1e7 + 1));
+    EXPECT_THAT(cos(wide)[0], Eq(interval(-1, 1)));
+}
+
+TEST_F(AnIntervalArray, reducesToHullMinimumAndMaximum) {
+    EXPECT_THAT(hull(a), Eq(interval(-4.1, 5)));
+    EXPECT_THAT(min(a), Eq(interval(-4.1, -0.1)));
+    EXPECT_THAT(max(b), Eq(interval(2, 5)));
+}
+
+TEST_F(AnIntervalArray, reducesArraysLargerThanRegisters) {
+    interval_array c(37, interval(0, 1));
+    c.set(33, interval(-2, 0.5));
+    c.set(4, interval(0.5, 3));
+    EXPECT_THAT(hull(c), Eq(interval(-2, 3)));
+    EXPECT_THAT(min(c), Eq(interval(-2, 0.5)));
+    EXPECT_THAT(max(c), Eq(interval(0.5, 3)));
+}
@@ -47,6 +47,105 @@ Eigen::Matrix<interval, 2, 2> rosenbrock2d_dd(const box<2>& b) {
     return s;
 }
 
+// All orders in one pass sharing b[1] - b[0]^2
+void rosenbrock2d_combined(const box<2>& b, unsigned flags, evaluation<2>& e) {
+    interval r = b[1] - sqr(b[0]);
+    if (flags & EVALUATE_VALUE) {
+        e.value = 100 * sqr(r) + sqr(b[0] - 1);
+    }
+    if (flags & EVALUATE_GRADIENT) {
+        e.gradient[1] = 200 * r;
+        e.gradient[0] = (1 - e.gradient[1]) * 2 * b[0] - 2;
+    }
+    if (flags & EVALUATE_HESSIAN) {
+        e.hessian(0,0) = -400 * b[0] * -2 * b[0] + -400 * r + 2;
+        e.hessian(1,1) = 200;
+        e.hessian(0,1) = -400 * b[0];
+        e.hessian(1,0) = e.hessian(0,1);
+    }
+}
+
+// Written once for intervals and duals
+struct rosenbrock2d_generic {
+    template<class T>
+    T operator()(const std::array<T, 2>& x) const {
+        return 100 * sqr(x[1] - sqr(x[0])) + sqr(x[0] - 1);
+    }
+};
+
+void rosenbrock2d_batch(const box_block<2>& b, interval* result) {
+    for (size_t k = 0; k < b.size(); ++k) {
+        result[k] = 100 * sqr(b[1][k] - sqr(b[0][k])) + sqr(b[0][k] - 1);
+    }
+}
+
+// Rosenbrock function of a dimension set at run time
+interval rosenbrock_dynamic(const box<dynamic>& b) {
+    interval r(0);
+    for (size_t i = 0; i + 1 < b.size(); ++i) {
+        r += 100 * sqr(b[i + 1] - sqr(b[i])) + sqr(b[i] - 1);
+    }
+    return r;
+}
+std::vector<interval> rosenbrock_dynamic_d(const box<dynamic>& b) {
+    std::vector<interval> s(b.size(), interval(0));
+    for (size_t i = 0; i + 1 < b.size(); ++i) {
+        interval t = 200 * (b[i + 1] - sqr(b[i]));
+        s[i] += (1 - t) * 2 * b[i] - 2;
+        s[i + 1] += t;
+    }
+    return s;
+}
+Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic>
+rosenbrock_dynamic_dd(const box<dynamic>& b) {
+    const size_t n = b.size();
+    Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> s(n, n);
+    s.setConstant(interval(0));
+    for (size_t i = 0; i + 1 < n; ++i) {
+        s(i,i) += -400 * b[i] * -2 * b[i] + -400 * (b[i + 1] - sqr(b[i])) + 2;
+        s(i + 1,i + 1) += 200;
+        s(i,i + 1) += -400 * b[i];
+        s(i + 1,i) += -400 * b[i];
+    }
+    return s;
+}
+
+// Separable quadratic with minimum 0 at x[i] = i/n
+interval shifted_sphere(const box<dynamic>& b) {
+    interval r(0);
+    for (size_t i = 0; i < b.size(); ++i) {
+        r += sqr(b[i] - static_cast<double>(i) / b.size());
+    }
+    return r;
+}
+std::vector<interval> shifted_sphere_d(const box<dynamic>& b) {
+    std::vector<interval> s(b.size());
+    for (size_t i = 0; i < b.size(); ++i) {
+        s[i] = 2 * (b[i] - static_cast<double>(i) / b.size());
+    }
+    return s;
+}
+Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic>
+shifted_sphere_dd(const box<dynamic>& b) {
+    Eigen::Matrix<interval, Eigen::Dynamic, Eigen::Dynamic> s(b.size(), b.size());
+    s.setConstant(interval(0));
+    s.diagonal().setConstant(interval(2));
+    return s;
+}
+
+// Unit disk, x^2 + y^2 <= 1
+interval unit_disk(const box<2>& b) {
+    return sqr(b[0]) + sqr(b[1]) - 1;
+}
+
+std::array<interval, 2> unit_disk_d(const box<2>& b) {
+    return {{2 * b[0], 2 * b[1]}};
+}
+
+interval sum2d(const box<2>& b) {
+    return b[0] + b[1];
+}
+
 interval bukin_no6(const box<2>& b) {
     return 100 * sqrt(abs(b[1] - 0.01 * sqr(b[0]))) + 0.01 * abs(b[0] + 10);
 }
@@ -118,6 +217,46 @@ TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DProvidingFirstDerivative) {
     std::cout << "Boxes: " << opt.box_count() << "\n";
 }
 
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DFromGenericObjective) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d_generic(), o);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DFromGenericObjectiveUsingTape) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.diff_mode = differentiation::REVERSE;
+    o.threads = 4;
+    optimizer<2> opt(rosenbrock2d_generic(), o);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
 TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DProvidingFirstAndSecondDerivative) {
     options_t o;
     o.epsilon = 1e-6;
@@ -138,3 +277,1049 @@ TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DProvidingFirstAndSecondDerivat
     std::cout << "CalcTime: " << opt.time() << "\n";
     std::cout << "Boxes: " << opt.box_count() << "\n";
 }
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DProvidingCombinedEvaluation) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_combined_function(rosenbrock2d_combined);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    // Same bounds as the separate callbacks, so the same search
+    optimizer<2> separate(rosenbrock2d, o);
+    separate.set_first_derivative(rosenbrock2d_d);
+    separate.set_second_derivative(rosenbrock2d_dd);
+    separate.solve(b);
+    EXPECT_THAT(opt.box_count(), Eq(separate.box_count()));
+
+    std::cout << "CalcTime: " << opt.time() << " (separate: "
+              << separate.time() << ")\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, takesRemainingOrdersFromSeparateCallbacks) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_combined_function(rosenbrock2d_combined,
+                              EVALUATE_VALUE | EVALUATE_GRADIENT);
+    opt.set_second_derivative(rosenbrock2d_dd);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DCallingLambdasDirectly) {
+    options_t o;
+    o.epsilon = 1e-6;
+    auto opt = make_optimizer<2>(
+        [](const box<2>& b) { return rosenbrock2d(b); },
+        [](const box<2>& b) { return rosenbrock2d_d(b); },
+        [](const box<2>& b) { return rosenbrock2d_dd(b); }, o);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    // Same search as through std::function
+    optimizer<2> erased(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+    erased.solve(b);
+    EXPECT_THAT(opt.box_count(), Eq(erased.box_count()));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, leavesOutDerivativesNotGivenToMakeOptimizer) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.bi_mode = bisection_mode::MAX_SMEAR_DIAM;
+    auto opt = make_optimizer<2>(rosenbrock2d, o);
+    box<2> b({interval(0,2), interval(-1,1.5)});
+    box<2> s = opt.solve(b);
+
+    optimizer<2> erased(rosenbrock2d, o);
+    erased.solve(b);
+
+    EXPECT_THAT(contains(s[0] + interval(-1e-5,1e-5), 1.0), Eq(true));
+    EXPECT_THAT(opt.box_count(), Eq(erased.box_count()));
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionOfDimensionSetAtRunTime) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<dynamic> opt(rosenbrock_dynamic, o);
+    opt.set_first_derivative(rosenbrock_dynamic_d);
+    opt.set_second_derivative(rosenbrock_dynamic_dd);
+
+    box<dynamic> b({interval(-5,5), interval(-5,5)});
+    box<dynamic> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    ASSERT_THAT(s.size(), Eq(2u));
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+
+    // Same search as with the dimension fixed at compile time
+    optimizer<2> fixed(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+    fixed.solve(box<2>({interval(-5,5), interval(-5,5)}));
+    EXPECT_THAT(opt.box_count(), Eq(fixed.box_count()));
+
+    std::cout << "CalcTime: " << opt.time() << " (fixed: "
+              << fixed.time() << ")\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, makesOptimizerOfDimensionSetAtRunTime) {
+    options_t o;
+    o.epsilon = 1e-6;
+    box<dynamic> b({interval(0,2), interval(-1,1.5)});
+
+    auto value_only = make_optimizer<dynamic>(rosenbrock_dynamic, o);
+    box<dynamic> s = value_only.solve(b);
+    optimizer<dynamic> erased(rosenbrock_dynamic, o);
+    erased.solve(b);
+    ASSERT_THAT(s.size(), Eq(2u));
+    EXPECT_THAT(contains(s[0] + interval(-1e-5,1e-5), 1.0), Eq(true));
+    EXPECT_THAT(value_only.box_count(), Eq(erased.box_count()));
+
+    auto first = make_optimizer<dynamic>(
+        rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+    first.solve(b);
+    optimizer<dynamic> erased_first(rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+    erased_first.solve(b);
+    EXPECT_THAT(first.box_count(), Eq(erased_first.box_count()));
+}
+
+TEST_F(AnOptimizer, canSolveProblemOfDimensionSetAtRunTimeUsingBatchEvaluationAndMultipleThreads) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.threads = 4;
+    optimizer<dynamic> opt(rosenbrock_dynamic, o);
+    opt.set_first_derivative(rosenbrock_dynamic_d);
+    opt.set_batch_function([](const box_block<dynamic>& b, interval* result) {
+        for (size_t k = 0; k < b.size(); ++k) {
+            result[k] = 100 * sqr(b[1][k] - sqr(b[0][k])) + sqr(b[0][k] - 1);
+        }
+    });
+
+    box<dynamic> b({interval(-5,5), interval(-5,5)});
+    box<dynamic> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+}
+
+TEST_F(AnOptimizer, canSolveProblemOfFortyDimensionsSetAtRunTime) {
+    const size_t n = 40;
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<dynamic> opt(shifted_sphere, o);
+    opt.set_first_derivative(shifted_sphere_d);
+    opt.set_second_derivative(shifted_sphere_dd);
+
+    box<dynamic> b(std::vector<interval>(n, interval(-1, 2)));
+    box<dynamic> s = opt.solve(b);
+
+    EXPECT_THAT(opt.minimum(), Lt(1e-10));
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_THAT(contains(s[i] + interval(-1e-6, 1e-6),
+                             static_cast<double>(i) / n), Eq(true)) << i;
+    }
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingMultipleThreads) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.threads = 4;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+    opt.set_second_derivative(rosenbrock2d_dd);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DFromThreadRoundingToNearest) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.threads = 4;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+    opt.set_second_derivative(rosenbrock2d_dd);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+    box<2> s = opt.solve(b);
+    EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_NEAREST));
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingBestFirstSearch) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::BEST_FIRST;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingBreadthFirstSearch) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::BREADTH_FIRST;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingHybridSearch) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::HYBRID;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingSmearBisection) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.bi_mode = bisection_mode::MAX_SMEAR_DIAM;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingRoundRobinBisection) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.bi_mode = bisection_mode::ROUND_ROBIN;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingRelativeDiamBisection) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.bi_mode = bisection_mode::MAX_RELATIVE_DIAM;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingTrisection) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.sections = 3;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingBatchEvaluation) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+    opt.set_batch_function(rosenbrock2d_batch);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DUsingBatchEvaluationAndMultipleThreads) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.threads = 4;
+    optimizer<2> opt(rosenbrock2d, o);
+    opt.set_first_derivative(rosenbrock2d_d);
+    opt.set_batch_function(rosenbrock2d_batch);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(diam(s[0]), Lt(1e-6));
+    EXPECT_THAT(diam(s[1]), Lt(1e-6));
+
+    std::cout << "CalcTime: " << opt.time() << "\n";
+    std::cout << "Boxes: " << opt.box_count() << "\n";
+}
+
+TEST_F(AnOptimizer, searchesSameBoxesStoringOpenBoxesCompactly) {
+    const search_mode modes[] = {search_mode::DEPTH_FIRST,
+        search_mode::BEST_FIRST, search_mode::BREADTH_FIRST,
+        search_mode::HYBRID};
+    for (search_mode mode : modes) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = mode;
+        // Small cap so hybrid search moves between stack and heap
+        o.max_open_boxes = 16;
+        optimizer<2> full(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        o.compact_boxes = true;
+        optimizer<2> compact(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+
+        box<2> b({interval(-5,5), interval(-5,5)});
+        box<2> s_full = full.solve(b);
+        box<2> s = compact.solve(b);
+
+        // Contracted boxes are rebuilt bit for bit
+        EXPECT_THAT(compact.box_count(), Eq(full.box_count()));
+        EXPECT_THAT(compact.minimum(), Eq(full.minimum()));
+        EXPECT_THAT(s[0], Eq(s_full[0]));
+        EXPECT_THAT(s[1], Eq(s_full[1]));
+    }
+}
+
+TEST_F(AnOptimizer, searchesSameBoxesStoringOpenBoxesCompactlyUsingBatchEvaluation) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::BEST_FIRST;
+    o.sections = 3;
+    optimizer<2> full(rosenbrock2d, rosenbrock2d_d, o);
+    full.set_batch_function(rosenbrock2d_batch);
+    o.compact_boxes = true;
+    optimizer<2> compact(rosenbrock2d, rosenbrock2d_d, o);
+    compact.set_batch_function(rosenbrock2d_batch);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    full.solve(b);
+    box<2> s = compact.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(compact.box_count(), Eq(full.box_count()));
+}
+
+TEST_F(AnOptimizer, searchesSameBoxesStoringOpenBoxesOfDimensionSetAtRunTimeCompactly) {
+    const size_t n = 6;
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::BEST_FIRST;
+    optimizer<dynamic> full(shifted_sphere, shifted_sphere_d, shifted_sphere_dd, o);
+    o.compact_boxes = true;
+    optimizer<dynamic> compact(shifted_sphere, shifted_sphere_d, shifted_sphere_dd, o);
+
+    box<dynamic> b(std::vector<interval>(n, interval(-1, 2)));
+    full.solve(b);
+    box<dynamic> s = compact.solve(b);
+
+    EXPECT_THAT(compact.minimum(), Lt(1e-10));
+    EXPECT_THAT(compact.box_count(), Eq(full.box_count()));
+    ASSERT_THAT(s.size(), Eq(n));
+}
+
+TEST_F(AnOptimizer, searchesSameBoxesSpillingOpenBoxesToFile) {
+    const search_mode modes[] = {search_mode::DEPTH_FIRST,
+        search_mode::BEST_FIRST, search_mode::BREADTH_FIRST,
+        search_mode::HYBRID};
+    for (search_mode mode : modes) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = mode;
+        o.max_open_boxes = 16;
+        optimizer<2> full(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        // Few boxes in memory so every list spills and reads back often
+        o.max_memory_boxes = 8;
+        optimizer<2> spilling(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+
+        box<2> b({interval(-5,5), interval(-5,5)});
+        box<2> s_full = full.solve(b);
+        box<2> s = spilling.solve(b);
+
+        // Heaps order boxes of equal rank differently
+        if (mode == search_mode::DEPTH_FIRST ||
+            mode == search_mode::BREADTH_FIRST) {
+            EXPECT_THAT(spilling.box_count(), Eq(full.box_count()));
+        }
+        EXPECT_THAT(spilling.minimum(), Eq(full.minimum()));
+        EXPECT_THAT(s[0], Eq(s_full[0]));
+        EXPECT_THAT(s[1], Eq(s_full[1]));
+    }
+}
+
+TEST_F(AnOptimizer, searchesSameBoxesSpillingOpenBoxesOfDimensionSetAtRunTimeToFile) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::BREADTH_FIRST;
+    optimizer<dynamic> full(rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+    o.max_memory_boxes = 4;
+    optimizer<dynamic> spilling(rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+
+    box<dynamic> b({interval(-5,5), interval(-5,5)});
+    full.solve(b);
+    box<dynamic> s = spilling.solve(b);
+
+    interval tolerance(-1e-5,1e-5);
+    ASSERT_THAT(s.size(), Eq(2u));
+    EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+    EXPECT_THAT(spilling.box_count(), Eq(full.box_count()));
+}
+
+TEST_F(AnOptimizer, throwsIfSpillFileCannotBeCreated) {
+    options_t o;
+    o.epsilon = 1e-6;
+    o.search = search_mode::BREADTH_FIRST;
+    o.max_memory_boxes = 2;
+    o.spill_directory = "/nonexistent/directory";
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    EXPECT_THROW(opt.solve(b), std::system_error);
+}
+
+TEST_F(AnOptimizer, removesPartialCheckpointIfItCannotReplaceTheLast) {
+    options_t o;
+    o.epsilon = 1e-6;
+    // A directory, which no finished checkpoint can be renamed over
+    o.checkpoint_file = TempDir() + ".";
+    o.checkpoint_boxes = 1;
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    EXPECT_THROW(opt.solve(b), std::system_error);
+    EXPECT_THAT(std::ifstream(o.checkpoint_file + ".partial").good(),
+                Eq(false));
+}
+
+TEST_F(AnOptimizer, throwsIfOpenBoxesOfThreadsCannotBeStoredAsAsked) {
+    box<2> b({interval(-5,5), interval(-5,5)});
+    options_t compact;
+    compact.threads = 2;
+    compact.compact_boxes = true;
+    options_t spilled;
+    spilled.threads = 2;
+    spilled.max_memory_boxes = 8;
+    options_t saved;
+    saved.threads = 2;
+    saved.checkpoint_file = TempDir() + "rapidlab_checkpoint_threads";
+    saved.checkpoint_boxes = 100;
+    for (const options_t& o : {compact, spilled, saved}) {
+        optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        EXPECT_THROW(opt.solve(b), std::invalid_argument);
+    }
+}
+
+TEST_F(AnOptimizer, throwsIfCompactBoxesGetMoreSectionsThanNodesHold) {
+    options_t o;
+    o.threads = 1;
+    o.compact_boxes = true;
+    o.sections = 1 << 16;
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+
+    box<2> b({interval(-5,5), interval(-5,5)});
+    EXPECT_THROW(opt.solve(b), std::invalid_argument);
+}
+
+TEST_F(AnOptimizer, resumesSearchFromCheckpointWithSameBoxes) {
+    const std::string path = TempDir() + "rapidlab_checkpoint";
+    const search_mode modes[] = {search_mode::DEPTH_FIRST,
+        search_mode::BEST_FIRST, search_mode::BREADTH_FIRST,
+        search_mode::HYBRID};
+    for (search_mode mode : modes) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = mode;
+        o.max_open_boxes = 16;
+        optimizer<2> full(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        box<2> b({interval(-5,5), interval(-5,5)});
+        box<2> s_full = full.solve(b);
+
+        // A single checkpoint halfway through the search, of full and of
+        // compact open boxes
+        o.checkpoint_file = path;
+        o.checkpoint_boxes = full.box_count() / 2 + 1;
+        for (bool compact : {false, true}) {
+            o.compact_boxes = compact;
+            optimizer<2> saving(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+            saving.solve(b);
+
+            // Options come from the checkpoint
+            optimizer<2> resumed(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd);
+            box<2> s = resumed.resume(path);
+
+            EXPECT_THAT(resumed.box_count(), Eq(full.box_count()));
+            EXPECT_THAT(resumed.minimum(), Eq(full.minimum()));
+            EXPECT_THAT(s[0], Eq(s_full[0]));
+            EXPECT_THAT(s[1], Eq(s_full[1]));
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(AnOptimizer, resumesSearchFromCheckpointOfSpilledOpenBoxes) {
+    const std::string path = TempDir() + "rapidlab_checkpoint_spilled";
+    const search_mode modes[] = {search_mode::DEPTH_FIRST,
+        search_mode::BREADTH_FIRST};
+    for (search_mode mode : modes) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = mode;
+        o.max_memory_boxes = 8;
+        optimizer<dynamic> full(rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+        box<dynamic> b({interval(-5,5), interval(-5,5)});
+        full.solve(b);
+
+        o.checkpoint_file = path;
+        o.checkpoint_boxes = full.box_count() / 2 + 1;
+        optimizer<dynamic> saving(rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+        saving.solve(b);
+
+        o.checkpoint_file.clear();
+        optimizer<dynamic> resumed(rosenbrock_dynamic, rosenbrock_dynamic_d, o);
+        box<dynamic> s = resumed.resume(path);
+
+        EXPECT_THAT(resumed.box_count(), Eq(full.box_count()));
+        EXPECT_THAT(resumed.minimum(), Eq(full.minimum()));
+        ASSERT_THAT(s.size(), Eq(2u));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(AnOptimizer, throwsIfResumedFromFileThatIsNoCheckpoint) {
+    const std::string path = TempDir() + "rapidlab_no_checkpoint";
+    std::ofstream(path) << "not a checkpoint";
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd);
+
+    EXPECT_THROW(opt.resume(path), std::runtime_error);
+    EXPECT_THROW(opt.resume(path + ".missing"), std::system_error);
+    std::remove(path.c_str());
+}
+
+TEST_F(AnOptimizer, countsWhatHappenedToEachBox) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+    box<2> b({interval(-5,5), interval(-5,5)});
+    opt.solve(b);
+
+    const solve_statistics& s = opt.statistics();
+    EXPECT_THAT(s.infeasible + s.monotonicity + s.nonconvexity +
+                s.gauss_seidel_empty + s.fritz_john_empty + s.cutoff +
+                s.tolerance + s.bisected, Eq(opt.box_count()));
+    EXPECT_THAT(s.monotonicity, Gt(0));
+    EXPECT_THAT(s.tolerance, Gt(0));
+    // Timings and the rest are not collected unless asked for
+    EXPECT_THAT(s.func_time, Eq(0));
+    EXPECT_THAT(s.peak_open_boxes, Eq(0u));
+    EXPECT_THAT(s.incumbents.empty(), Eq(true));
+}
+
+TEST_F(AnOptimizer, collectsTimingsAndIncumbentsOnRequest) {
+    const unsigned thread_counts[] = {1, 3};
+    for (unsigned threads : thread_counts) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.threads = threads;
+        o.collect_statistics = true;
+        optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        box<2> b({interval(-5,5), interval(-5,5)});
+        opt.solve(b);
+
+        const solve_statistics& s = opt.statistics();
+        EXPECT_THAT(s.infeasible + s.monotonicity + s.nonconvexity +
+                    s.gauss_seidel_empty + s.fritz_john_empty + s.cutoff +
+                    s.tolerance + s.bisected, Eq(opt.box_count()));
+        EXPECT_THAT(s.func_time, Gt(0));
+        EXPECT_THAT(s.func_d_time, Gt(0));
+        EXPECT_THAT(s.func_dd_time, Gt(0));
+        EXPECT_THAT(s.gauss_seidel_time, Gt(0));
+        EXPECT_THAT(s.bisection_time, Gt(0));
+        EXPECT_THAT(s.peak_open_boxes, Gt(1u));
+        EXPECT_THAT(s.gauss_seidel_width_ratio,
+                    Le(static_cast<double>(s.gauss_seidel_contracted)));
+        // Improvements only, ending at the minimum
+        ASSERT_THAT(s.incumbents.empty(), Eq(false));
+        for (size_t k = 1; k < s.incumbents.size(); ++k) {
+            EXPECT_THAT(s.incumbents[k].value, Lt(s.incumbents[k - 1].value));
+            EXPECT_THAT(s.incumbents[k].time, Ge(s.incumbents[k - 1].time));
+        }
+        EXPECT_THAT(s.incumbents.back().value, Eq(opt.minimum()));
+    }
+}
+
+TEST_F(AnOptimizer, stopsAtBoxLimitWithBoundOfGlobalMinimum) {
+    const unsigned thread_counts[] = {1, 3};
+    for (unsigned threads : thread_counts) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = search_mode::BEST_FIRST;
+        o.threads = threads;
+        o.max_boxes = 50;
+        optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        box<2> b({interval(-5,5), interval(-5,5)});
+        opt.solve(b);
+
+        EXPECT_THAT(opt.stopped_by(), Eq(stop_reason::BOXES));
+        EXPECT_THAT(opt.box_count(), Ge(50));
+        EXPECT_THAT(opt.box_count(), Lt(60));
+        EXPECT_THAT(opt.open_box_count(), Gt(0u));
+        // Rosenbrock has its minimum 0 at (1,1)
+        EXPECT_THAT(opt.lower_bound(), Le(0.0));
+        EXPECT_THAT(opt.lower_bound(), Gt(-INFINITY));
+        EXPECT_THAT(opt.minimum(), Ge(0.0));
+    }
+}
+
+TEST_F(AnOptimizer, stopsAtBoxLimitWithSameBoundSpillingOpenBoxesToFile) {
+    const search_mode modes[] = {search_mode::DEPTH_FIRST,
+        search_mode::BREADTH_FIRST};
+    for (search_mode mode : modes) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = mode;
+        o.max_boxes = 200;
+        optimizer<2> full(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        // Most open boxes are spilled when the search stops
+        o.max_memory_boxes = 8;
+        optimizer<2> spilling(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+
+        box<2> b({interval(-5,5), interval(-5,5)});
+        full.solve(b);
+        spilling.solve(b);
+
+        EXPECT_THAT(spilling.open_box_count(), Eq(full.open_box_count()));
+        EXPECT_THAT(spilling.open_box_count(), Gt(8u));
+        EXPECT_THAT(spilling.lower_bound(), Eq(full.lower_bound()));
+    }
+}
+
+TEST_F(AnOptimizer, closesGapWhenSearchIsComplete) {
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+    box<2> b({interval(-5,5), interval(-5,5)});
+    opt.solve(b);
+
+    EXPECT_THAT(opt.stopped_by(), Eq(stop_reason::COMPLETE));
+    EXPECT_THAT(opt.open_box_count(), Eq(0u));
+    EXPECT_THAT(opt.lower_bound(), Le(0.0));
+    EXPECT_THAT(opt.minimum() - opt.lower_bound(), Lt(1e-6));
+}
+
+TEST_F(AnOptimizer, stopsAtTimeAndMemoryLimits) {
+    // Nothing of a constant function is ever cut off
+    auto constant = [](const box<2>&) { return interval(1); };
+    options_t o;
+    o.epsilon = 1e-12;
+    o.search = search_mode::BREADTH_FIRST;
+    o.max_time = 1e-3;
+    auto timed = make_optimizer<2>(constant, o);
+    box<2> b({interval(-5,5), interval(-5,5)});
+    timed.solve(b);
+    EXPECT_THAT(timed.stopped_by(), Eq(stop_reason::TIME));
+    EXPECT_THAT(timed.time(), Lt(0.5));
+
+    o.max_time = 0;
+    o.max_memory = 100 * sizeof(box<2>);
+    auto bounded = make_optimizer<2>(constant, o);
+    bounded.solve(b);
+    EXPECT_THAT(bounded.stopped_by(), Eq(stop_reason::MEMORY));
+    EXPECT_THAT(bounded.open_box_count(), Le(102u));
+    EXPECT_THAT(bounded.lower_bound(), Eq(1.0));
+}
+
+TEST_F(AnOptimizer, reportsShrinkingGapUntilProgressFunctionStopsIt) {
+    const unsigned thread_counts[] = {1, 3};
+    for (unsigned threads : thread_counts) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = search_mode::BEST_FIRST;
+        o.threads = threads;
+        o.progress_boxes = 10;
+        optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        std::vector<solve_progress> reports;
+        opt.set_progress_function([&](const solve_progress& p) {
+            reports.push_back(p);
+            return p.gap > 1e-2;
+        });
+        box<2> b({interval(-5,5), interval(-5,5)});
+        opt.solve(b);
+
+        ASSERT_THAT(reports.size(), Gt(1u));
+        EXPECT_THAT(opt.stopped_by(), Eq(stop_reason::PROGRESS));
+        EXPECT_THAT(reports.back().gap, Le(1e-2));
+        for (const solve_progress& p : reports) {
+            EXPECT_THAT(p.lower_bound, Le(0.0));
+            EXPECT_THAT(p.gap, Eq(p.minimum - p.lower_bound));
+        }
+        EXPECT_THAT(opt.lower_bound(), Le(0.0));
+    }
+}
+
+TEST_F(AnOptimizer, lowersIncumbentEarlierBySearchingLocally) {
+    const bool with_hessian[] = {false, true};
+    for (bool hessian : with_hessian) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.search = search_mode::BEST_FIRST;
+        optimizer<2> plain(rosenbrock2d, rosenbrock2d_d, o);
+        if (hessian) {
+            plain.set_second_derivative(rosenbrock2d_dd);
+        }
+        box<2> b({interval(-5,5), interval(-5,5)});
+        plain.solve(b);
+
+        o.local_search_boxes = 16;
+        optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, o);
+        if (hessian) {
+            opt.set_second_derivative(rosenbrock2d_dd);
+        }
+        box<2> s = opt.solve(b);
+
+        interval tolerance(-1e-5,1e-5);
+        EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+        EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+        EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+        EXPECT_THAT(opt.statistics().local_searches, Gt(0));
+        EXPECT_THAT(opt.statistics().local_improvements, Gt(0));
+        EXPECT_THAT(opt.box_count(), Le(plain.box_count()));
+
+        std::cout << "Boxes: " << plain.box_count() << " without, "
+                  << opt.box_count() << " with local search\n";
+    }
+}
+
+TEST_F(AnOptimizer, seedsIncumbentFromQuasiRandomPointsBeforeBranching) {
+    const unsigned thread_counts[] = {1, 3};
+    const bool batches[] = {false, true};
+    for (unsigned threads : thread_counts) {
+        for (bool batch : batches) {
+            options_t o;
+            o.epsilon = 1e-6;
+            o.threads = threads;
+            o.collect_statistics = true;
+            optimizer<2> plain(rosenbrock2d, rosenbrock2d_d, o);
+            if (batch) {
+                plain.set_batch_function(rosenbrock2d_batch);
+            }
+            box<2> b({interval(-5,5), interval(-5,5)});
+            plain.solve(b);
+
+            o.seed_points = 1000;
+            optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, o);
+            if (batch) {
+                opt.set_batch_function(rosenbrock2d_batch);
+            }
+            box<2> s = opt.solve(b);
+
+            interval tolerance(-1e-5,1e-5);
+            EXPECT_THAT(contains(0.0 + tolerance, opt.minimum()), Eq(true));
+            EXPECT_THAT(contains(s[0] + tolerance, 1.0), Eq(true));
+            EXPECT_THAT(contains(s[1] + tolerance, 1.0), Eq(true));
+            // The first incumbent comes before any box is processed
+            const solve_statistics& st = opt.statistics();
+            ASSERT_THAT(st.incumbents.empty(), Eq(false));
+            EXPECT_THAT(st.incumbents.front().boxes, Eq(0));
+            // Batches find the valley early anyway
+            if (threads == 1 && !batch) {
+                EXPECT_THAT(opt.box_count(), Lt(plain.box_count()));
+            }
+
+            std::cout << "Boxes: " << plain.box_count() << " without, "
+                      << opt.box_count() << " with seeding\n";
+        }
+    }
+}
+
+TEST_F(AnOptimizer, canSolveRosenbrockFunctionIn2DConstrainedToUnitDisk) {
+    const unsigned thread_counts[] = {1, 3};
+    const bool batches[] = {false, true};
+    for (unsigned threads : thread_counts) {
+        for (bool batch : batches) {
+            options_t o;
+            o.epsilon = 1e-6;
+            o.threads = threads;
+            optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+            if (batch) {
+                opt.set_batch_function(rosenbrock2d_batch);
+            }
+            opt.add_constraint(unit_disk);
+            box<2> b({interval(-5,5), interval(-5,5)});
+            box<2> s = opt.solve(b);
+
+            // Minimum on the circle at (0.7864, 0.6177)
+            interval tolerance(-1e-3,1e-3);
+            EXPECT_THAT(contains(0.045675 + tolerance, opt.minimum()), Eq(true));
+            EXPECT_THAT(contains(s[0] + tolerance, 0.7864), Eq(true));
+            EXPECT_THAT(contains(s[1] + tolerance, 0.6177), Eq(true));
+            EXPECT_THAT(unit_disk(s).upper(), Le(0.0));
+            const solve_statistics& st = opt.statistics();
+            EXPECT_THAT(st.infeasible, Gt(0));
+            EXPECT_THAT(st.infeasible + st.monotonicity + st.nonconvexity +
+                        st.gauss_seidel_empty + st.fritz_john_empty +
+                        st.cutoff + st.tolerance + st.bisected,
+                        Eq(opt.box_count()));
+
+            std::cout << "Boxes: " << opt.box_count() << "\n";
+        }
+    }
+}
+
+TEST_F(AnOptimizer, checksConstraintsThatRejectBoxesCheaplyFirst) {
+    // Slow and never violated, and fast and often violated
+    int64_t slow_calls = 0, fast_calls = 0;
+    options_t o;
+    o.epsilon = 1e-6;
+    optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+    opt.add_constraint([&](const box<2>& b) {
+        ++slow_calls;
+        interval r(0);
+        for (int k = 0; k < 100; ++k) {
+            r = sqr(r + b[0]) / 100;
+        }
+        return r * 0 - 1;
+    });
+    opt.add_constraint([&](const box<2>& b) {
+        ++fast_calls;
+        return unit_disk(b);
+    });
+    box<2> b({interval(-5,5), interval(-5,5)});
+    opt.solve(b);
+
+    EXPECT_THAT(opt.statistics().infeasible, Gt(0));
+    EXPECT_THAT(slow_calls, Lt(fast_calls));
+}
+
+TEST_F(AnOptimizer, provesFeasiblePointsOfEqualityConstraintsForIncumbent) {
+    const unsigned thread_counts[] = {1, 3};
+    for (unsigned threads : thread_counts) {
+        options_t o;
+        o.epsilon = 1e-4;
+        o.threads = threads;
+        optimizer<2> opt(sum2d, o);
+        opt.add_equality_constraint(unit_disk, unit_disk_d);
+        box<2> b({interval(-5,5), interval(-5,5)});
+        box<2> s = opt.solve(b);
+
+        // Minimum on the unit circle at -(1,1)/sqrt(2), bounding the sum
+        // over a box holding a point of the circle
+        const double x = -std::sqrt(0.5);
+        EXPECT_THAT(opt.minimum(), Ge(-std::sqrt(2.0)));
+        EXPECT_THAT(opt.minimum(), Le(-std::sqrt(2.0) + 1e-3));
+        EXPECT_THAT(contains(s[0] + interval(-1e-3,1e-3), x), Eq(true));
+        EXPECT_THAT(contains(s[1] + interval(-1e-3,1e-3), x), Eq(true));
+        EXPECT_THAT(contains(unit_disk(s), 0.0), Eq(true));
+        EXPECT_THAT(opt.statistics().existence_proofs, Gt(0));
+        EXPECT_THAT(opt.statistics().infeasible, Gt(0));
+
+        std::cout << "Boxes: " << opt.box_count() << "\n";
+    }
+}
+
+TEST_F(AnOptimizer, keepsIncumbentsOfEqualityConstraintsWithinInequalities) {
+    options_t o;
+    o.epsilon = 1e-4;
+    optimizer<2> opt(sum2d, o);
+    opt.add_equality_constraint(unit_disk, unit_disk_d);
+    opt.add_constraint([](const box<2>& b) { return -b[0]; });
+    box<2> b({interval(-5,5), interval(-5,5)});
+    box<2> s = opt.solve(b);
+
+    // Minimum on the right half of the circle at (0,-1)
+    EXPECT_THAT(opt.minimum(), Ge(-1.0));
+    EXPECT_THAT(opt.minimum(), Le(-1.0 + 1e-3));
+    EXPECT_THAT(s[0].lower(), Ge(0.0));
+    EXPECT_THAT(contains(s[1] + interval(-1e-3,1e-3), -1.0), Eq(true));
+}
+
+TEST_F(AnOptimizer, rejectsBoxesWithoutFritzJohnPointsGivenConstraintGradients) {
+    const unsigned thread_counts[] = {1, 3};
+    for (unsigned threads : thread_counts) {
+        options_t o;
+        o.epsilon = 1e-6;
+        o.threads = threads;
+        optimizer<2> plain(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        plain.add_constraint(unit_disk);
+        box<2> b({interval(-5,5), interval(-5,5)});
+        plain.solve(b);
+
+        optimizer<2> opt(rosenbrock2d, rosenbrock2d_d, rosenbrock2d_dd, o);
+        opt.add_constraint(unit_disk, unit_disk_d);
+        box<2> s = opt.solve(b);
+
+        interval tolerance(-1e-3,1e-3);
+        EXPECT_THAT(contains(0.045675 + tolerance, opt.minimum()), Eq(true));
+        EXPECT_THAT(contains(s[0] + tolerance, 0.7864), Eq(true));
+        EXPECT_THAT(contains(s[1] + tolerance, 0.6177), Eq(true));
+        const solve_statistics& st = opt.statistics();
+        EXPECT_THAT(st.fritz_john_empty, Gt(0));
+        EXPECT_THAT(st.infeasible + st.monotonicity + st.nonconvexity +
+                    st.gauss_seidel_empty + st.fritz_john_empty +
+                    st.cutoff + st.tolerance + st.bisected,
+                    Eq(opt.box_count()));
+        if (threads == 1) {
+            EXPECT_THAT(opt.box_count(), Lt(plain.box_count()));
+        }
+
+        std::cout << "Boxes: " << plain.box_count() << " without, "
+                  << opt.box_count() << " with the Fritz John test\n";
+    }
+}
+
+TEST_F(AnOptimizer, rejectsBoxesWithoutFritzJohnPointsOfEqualityConstraints) {
+    options_t o;
+    o.epsilon = 1e-4;
+    optimizer<2> plain(sum2d, o);
+    plain.add_equality_constraint(unit_disk, unit_disk_d);
+    box<2> b({interval(-5,5), interval(-5,5)});
+    plain.solve(b);
+
+    // Gradient of the objective enables the test
+    optimizer<2> opt(sum2d, [](const box<2>&) {
+        return std::array<interval, 2>{{interval(1), interval(1)}};
+    }, o);
+    opt.add_equality_constraint(unit_disk, unit_disk_d);
+    opt.solve(b);
+
+    EXPECT_THAT(opt.minimum(), Ge(-std::sqrt(2.0)));
+    EXPECT_THAT(opt.minimum(), Le(-std::sqrt(2.0) + 1e-3));
+    EXPECT_THAT(opt.statistics().fritz_john_empty, Gt(0));
+    EXPECT_THAT(opt.box_count(), Lt(plain.box_count()));
+
+    std::cout << "Boxes: " << plain.box_count() << " without, "
+              << opt.box_count() << " with the Fritz John test\n";
+}
@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/packed.hpp"
+
+using namespace rapidlab;
+using namespace testing;
+
+class APackedInterval : public Test {
+public:
+    // Positive, negative and zero spanning intervals
+    interval a[4] = {interval(0.1, 4.1), interval(-4.1, -0.1),
+                     interval(-4.1, 0.1), interval(2, 3)};
+    interval b[4] = {interval(-3, -2), interval(0.3, 1.7),
+                     interval(-0.2, 5), interval(-1, 0.5)};
+
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+    }
+
+    // Every packed result must equal the scalar result bit by bit
+    template <class packed_t>
+    void expectEqualToScalar(const packed_t& p, const interval* expected) {
+        for (size_t k = 0; k < packed_t::size; ++k) {
+            EXPECT_THAT(p[k].lower(), DoubleEq(expected[k].lower())) << k;
+            EXPECT_THAT(p[k].upper(), DoubleEq(expected[k].upper())) << k;
+        }
+    }
+};
+
+TEST_F(APackedInterval, loadsAndStoresIntervals) {
+    interval_x4 x(a);
+    interval r[4];
+    x.store(r);
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_THAT(r[k], Eq(a[k]));
+        EXPECT_THAT(x[k], Eq(a[k]));
+    }
+}
+
+TEST_F(APackedInterval, canBeAddedAndSubtractedLikeScalars) {
+    interval_x4 x(a), y(b);
+    interval sum[4], difference[4], shifted[4];
+    for (size_t k = 0; k < 4; ++k) {
+        sum[k] = a[k] + b[k];
+        difference[k] = a[k] - b[k];
+        shifted[k] = 3 - a[k];
+    }
+    expectEqualToScalar(x + y, sum);
+    expectEqualToScalar(x - y, difference);
+    expectEqualToScalar(3 - x, shifted);
+}
+
+TEST_F(APackedInterval, canBeMultipliedLikeScalars) {
+    interval_x4 x(a), y(b);
+    interval product[4], scaled[4];
+    for (size_t k = 0; k < 4; ++k) {
+        product[k] = a[k] * b[k];
+        scaled[k] = a[k] * -2.5;
+    }
+    expectEqualToScalar(x * y, product);
+    expectEqualToScalar(x * -2.5, scaled);
+    expectEqualToScalar(-2.5 * x, scaled);
+}
+
+TEST_F(APackedInterval, canBeMultipliedWithAZeroSpanInterval) {
+    interval_x4 x(a), y(interval(-0.2, 0.1));
+    interval product[4];
+    for (size_t k = 0; k < 4; ++k) {
+        product[k] = a[k] * interval(-0.2, 0.1);
+    }
+    expectEqualToScalar(x * y, product);
+}
+
+TEST_F(APackedInterval, canBeDividedLikeScalars) {
+    interval_x4 x(a), y(b);
+    interval quotient[4], reciprocal[4];
+    for (size_t k = 0; k < 4; ++k) {
+        quotient[k] = a[k] / b[k];
+        reciprocal[k] = 1.1 / a[k];
+    }
+    expectEqualToScalar(x / y, quotient);
+    expectEqualToScalar(1.1 / x, reciprocal);
+}
+
+TEST_F(APackedInterval, hasSquareLikeScalars) {
+    interval_x4 x(a);
+    interval_x4 c = sqr(x);
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_THAT(c[k], Eq(sqr(a[k])));
+    }
+}
+
+TEST_F(APackedInterval, hasAbsoluteLikeScalars) {
+    interval_x4 x(a);
+    interval_x4 c = abs(x);
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_THAT(c[k], Eq(abs(a[k])));
+    }
+}
+
+TEST_F(APackedInterval, hasSquareRootResultingInNanForNegativeLowerBound) {
+    interval_x4 x(a);
+    interval_x4 c = sqrt(x);
+    EXPECT_THAT(c[0], Eq(sqrt(a[0])));
+    EXPECT_THAT(c[3], Eq(sqrt(a[3])));
+    EXPECT_THAT(std::isnan(c[1].lower()), Eq(true));
+    EXPECT_THAT(std::isnan(c[1].upper()), Eq(true));
+    EXPECT_THAT(std::isnan(c[2].lower()), Eq(true));
+    EXPECT_THAT(std::isnan(c[2].upper()), Eq(true));
+}
+
+TEST_F(APackedInterval, hasMidPointAndDiameter) {
+    interval_x4 x(a);
+    std::array<double, 4> m = mid(x);
+    std::array<double, 4> d = diam(x);
+    for (size_t k = 0; k < 4; ++k) {
+        EXPECT_THAT(m[k], DoubleEq(mid(a[k])));
+        EXPECT_THAT(d[k], DoubleEq(diam(a[k])));
+    }
+}
+
+TEST_F(APackedInterval, hasCheckWhetherItSpansZero) {
+    interval_x4 x(a), y(b);
+    EXPECT_THAT(zero_in(x), Eq(4));
+    EXPECT_THAT(zero_in(y), Eq(12));
+}
+
+TEST_F(APackedInterval, hasIntersection) {
+    interval_x4 x(a), y(b);
+    interval_x4 c = intersect(x, y);
+    for (size_t k = 0; k < 4; ++k) {
+        interval expected = intersect(a[k], b[k]);
+        if (std::isnan(expected.lower())) {
+            EXPECT_THAT(std::isnan(c[k].lower()), Eq(true)) << k;
+            EXPECT_THAT(std::isnan(c[k].upper()), Eq(true)) << k;
+        } else {
+            EXPECT_THAT(c[k], Eq(expected)) << k;
+        }
+    }
+}
+
+TEST_F(APackedInterval, ofTwoIntervalsHasSameResultsAsScalars) {
+    interval_x2 x(a), y(b);
+    interval expected[2];
+    for (size_t k = 0; k < 2; ++k) {
+        expected[k] = sqr(a[k] - b[k]) * a[k] / b[k];
+    }
+    expectEqualToScalar(sqr(x - y) * x / y, expected);
+}
@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/rounding.hpp"
+
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace rapidlab;
+using namespace testing;
+
+class ARoundingPolicy : public Test {
+public:
+    std::vector<double> x;
+    std::vector<double> y;
+
+    void SetUp() override final {
+        // Operands over the full exponent range with both signs
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> mantissa(1, 2);
+        std::uniform_int_distribution<int> exponent(-1070, 1020);
+        for (int i = 0; i < 20000; ++i) {
+            double m = (rng() & 1) ? -mantissa(rng) : mantissa(rng);
+            x.push_back(std::ldexp(m, exponent(rng) / (i % 4 + 1)));
+            m = (rng() & 1) ? -mantissa(rng) : mantissa(rng);
+            y.push_back(std::ldexp(m, exponent(rng) / (i % 4 + 1)));
+        }
+        // Exactly representable results and special values
+        const double special[] = {0.0, -0.0, 1.0, -1.0, 0.5, 3.0, 0x1p-1074,
+                                  DBL_MAX, -DBL_MAX, INFINITY, -INFINITY};
+        for (double a : special) {
+            for (double b : special) {
+                x.push_back(a);
+                y.push_back(b);
+            }
+        }
+        // Operands are evaluated in pairs
+        if (x.size() % 2) {
+            x.push_back(2.0);
+            y.push_back(3.0);
+        }
+    }
+
+    // Applies op to all operands in pairs under the given policy
+    template<class policy, class F>
+    std::vector<double> evaluate(F op) {
+        rounding_guard<policy> guard;
+        std::vector<double> r(x.size());
+        for (size_t i = 0; i < x.size(); i += 2) {
+            __m128d v = op(_mm_set_pd(x[i+1], x[i]), _mm_set_pd(y[i+1], y[i]));
+            _mm_storeu_pd(&r[i], v);
+        }
+        return r;
+    }
+
+    // Error-free transformations are exact without underflow, and without
+    // overflow of Dekker's splitting where there is no FMA
+    static bool exact(double v) {
+        double a = std::fabs(v);
+        return a == 0 || std::isinf(a) || (a >= 0x1p-969 && a <= 0x1p995);
+    }
+
+    // Round to nearest must reproduce upward rounding bit by bit
+    template<class F, class G>
+    void expectSameAsUpward(F nearest_op, G upward_op) {
+        std::vector<double> n = evaluate<rounding::nearest>(nearest_op);
+        std::vector<double> u = evaluate<rounding::upward>(upward_op);
+        for (size_t i = 0; i < x.size(); ++i) {
+            if (std::isnan(u[i])) {
+                EXPECT_THAT(std::isnan(n[i]), Eq(true)) << x[i] << " " << y[i];
+            } else if (!exact(x[i]) || !exact(y[i]) || !exact(u[i])) {
+                // Outside the range of exact error terms one step above
+                EXPECT_THAT(n[i], Ge(u[i])) << x[i] << " " << y[i];
+                EXPECT_THAT(n[i], Le(std::nextafter(u[i], INFINITY)))
+                    << x[i] << " " << y[i];
+            } else {
+                EXPECT_THAT(n[i], Eq(u[i])) << x[i] << " " << y[i];
+            }
+        }
+    }
+
+    // Operator suite over intervals of all sign combinations
+    template<class policy>
+    std::vector<interval> intervalResults() {
+        const interval a[] = {interval(0.1, 4.1), interval(-4.1, -0.1),
+                              interval(-4.1, 0.1), interval(1.0/3, 2)};
+        const interval b[] = {interval(-3, -2.2), interval(0.3, 1.7),
+                              interval(-0.2, 5), interval(0.7)};
+        rounding_guard<policy> guard;
+        std::vector<interval> r;
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) {
+                r.push_back(detail::add<policy>(a[i], b[j]));
+                r.push_back(detail::mul<policy>(a[i], b[j]));
+                r.push_back(detail::div<policy>(a[i], b[j]));
+                r.push_back(detail::mul<policy>(a[i], y[j]));
+                r.push_back(detail::sqr<policy>(a[i]));
+                r.push_back(detail::sqrt<policy>(b[j]));
+            }
+        }
+        return r;
+    }
+
+    static __m128d n_add(__m128d a, __m128d b) { return rounding::nearest::add(a, b); }
+    static __m128d n_mul(__m128d a, __m128d b) { return rounding::nearest::mul(a, b); }
+    static __m128d n_div(__m128d a, __m128d b) { return rounding::nearest::div(a, b); }
+    static __m128d n_sqrt(__m128d a, __m128d) {
+        return rounding::nearest::sqrt(_mm_andnot_pd(_mm_set1_pd(-0.0), a));
+    }
+    static __m128d u_add(__m128d a, __m128d b) { return rounding::upward::add(a, b); }
+    static __m128d u_mul(__m128d a, __m128d b) { return rounding::upward::mul(a, b); }
+    static __m128d u_div(__m128d a, __m128d b) { return rounding::upward::div(a, b); }
+    static __m128d u_sqrt(__m128d a, __m128d) {
+        return rounding::upward::sqrt(_mm_andnot_pd(_mm_set1_pd(-0.0), a));
+    }
+};
+
+TEST_F(ARoundingPolicy, addsUpwardUnderRoundToNearest) {
+    expectSameAsUpward(n_add, u_add);
+}
+
+TEST_F(ARoundingPolicy, multipliesUpwardUnderRoundToNearest) {
+    expectSameAsUpward(n_mul, u_mul);
+}
+
+TEST_F(ARoundingPolicy, dividesUpwardUnderRoundToNearest) {
+    expectSameAsUpward(n_div, u_div);
+}
+
+TEST_F(ARoundingPolicy, takesSquareRootUpwardUnderRoundToNearest) {
+    expectSameAsUpward(n_sqrt, u_sqrt);
+}
+
+TEST_F(ARoundingPolicy, givesSameIntervalsUnderRoundToNearest) {
+    std::vector<interval> n = intervalResults<rounding::nearest>();
+    std::vector<interval> u = intervalResults<rounding::upward>();
+    for (size_t i = 0; i < u.size(); ++i) {
+        if (std::isnan(u[i].lower())) continue;
+        EXPECT_THAT(n[i], Eq(u[i])) << i;
+    }
+}
+
+TEST_F(ARoundingPolicy, restoresRoundingModeAfterGuard) {
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_TOWARD_ZERO);
+    {
+        rounding_guard<rounding::upward> guard;
+        EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_UP));
+        {
+            rounding_guard<rounding::nearest> inner;
+            EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_NEAREST));
+        }
+        EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_UP));
+    }
+    EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_TOWARD_ZERO));
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+}
+
+TEST_F(ARoundingPolicy, installsContextOnWorkerThreads) {
+    rounding_guard<rounding::upward> guard;
+    rounding_context<rounding::upward> context;
+    _MM_SET_ROUNDING_MODE(_MM_ROUND_NEAREST);
+
+    unsigned int mode = 0;
+    interval r;
+    auto task = context.wrap([&](const interval& a) {
+        mode = _MM_GET_ROUNDING_MODE();
+        r = a / 3.0;
+    });
+    std::thread worker(task, interval(1));
+    worker.join();
+    EXPECT_THAT(mode, Eq(_MM_ROUND_UP));
+    EXPECT_THAT(r.upper(), Gt(r.lower()));
+
+    {
+        rounding_context<rounding::upward>::scope installed(context);
+        EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_UP));
+    }
+    EXPECT_THAT(_MM_GET_ROUNDING_MODE(), Eq(_MM_ROUND_NEAREST));
+}
+
+#ifndef NDEBUG
+TEST_F(ARoundingPolicy, detectsWrongRoundingModeInDebugBuilds) {
+    rounding_guard<rounding::nearest> guard;
+    interval a(1, 2);
+    EXPECT_DEATH(detail::add<rounding::upward>(a, a), "rounding mode");
+    EXPECT_DEATH(detail::mul<rounding::upward>(a, a), "rounding mode");
+}
+#endif
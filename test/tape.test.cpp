@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "interval/core.hpp"
+#include "interval/dual.hpp"
+#include "interval/tape.hpp"
+
+using namespace rapidlab;
+using namespace testing;
+
+struct rosenbrock {
+    template<class T>
+    T operator()(const std::array<T, 2>& x) const {
+        return 100 * sqr(x[1] - sqr(x[0])) + sqr(x[0] - 1);
+    }
+};
+
+// Uses every recorded operation
+struct mixed {
+    template<class T>
+    T operator()(const std::array<T, 3>& x) const {
+        T s = 0;
+        s += x[0] * x[1] / (x[2] + 3) - sqrt(x[2]);
+        s += exp(x[0]) * log(x[1]) + sin(x[0] * x[2]) - cos(x[1]);
+        s -= -abs(x[0] - 4) * 2;
+        return s;
+    }
+};
+
+class ATape : public Test {
+public:
+    void SetUp() override final {
+        // Initialize every test by rounding to infinity
+        _MM_SET_ROUNDING_MODE(_MM_ROUND_UP);
+    }
+
+    // Replays must give the bounds of the forward mode
+    template<size_t _size, class F>
+    void expectGradientOfForwardMode(const F& f, const tape& t,
+                                     const box<_size>& b) {
+        tape::sweep s;
+        dual<_size> d = f(variables(b));
+        EXPECT_THAT(s.forward(t, b), Eq(d.value()));
+        std::array<interval, _size> g;
+        s.gradient(g.data());
+        for (size_t k = 0; k < _size; ++k) {
+            EXPECT_THAT(contains(g[k], mid(d[k])), Eq(true)) << k;
+            EXPECT_THAT(diam(g[k]), Le(2 * diam(d[k]) + 1e-12)) << k;
+        }
+    }
+};
+
+TEST_F(ATape, recordsOperationsOnce) {
+    tape t = tape::record<2>(rosenbrock());
+    EXPECT_THAT(t.input_count(), Eq(2u));
+    // Two inputs, two constants, seven operations
+    EXPECT_THAT(t.size(), Eq(11u));
+}
+
+TEST_F(ATape, evaluatesConstantsWithoutRecording) {
+    tape_var a(interval(1, 2));
+    tape_var r = sqr(a) * 2 + 1;
+    EXPECT_THAT(r.recording(), Eq(nullptr));
+    EXPECT_THAT(r.constant(), Eq(interval(3, 9)));
+}
+
+TEST_F(ATape, givesGradientOfForwardMode) {
+    tape t = tape::record<2>(rosenbrock());
+    expectGradientOfForwardMode(rosenbrock(), t,
+                                box<2>({interval(-1, 2), interval(0.5, 1)}));
+    tape m = tape::record<3>(mixed());
+    expectGradientOfForwardMode(mixed(), m,
+        box<3>({interval(0.5, 1), interval(1, 2), interval(0.25, 0.5)}));
+}
+
+TEST_F(ATape, isReusedAcrossBoxes) {
+    tape t = tape::record<3>(mixed());
+    const size_t recorded = t.size();
+    for (int k = 0; k < 4; ++k) {
+        box<3> b({interval(0.1 * k, 0.1 * k + 0.2), interval(1 + k, 2 + k),
+                  interval(0.5, 0.5 + k)});
+        expectGradientOfForwardMode(mixed(), t, b);
+    }
+    EXPECT_THAT(t.size(), Eq(recorded));
+}
+
+TEST_F(ATape, givesHessianColumns) {
+    tape t = tape::record<2>(rosenbrock());
+    box<2> b({interval(-1, 2), interval(0.5, 1)});
+    tape::sweep s;
+    s.forward(t, b);
+    std::array<interval, 2> h0, h1;
+    s.hessian_column(0, h0.data());
+    s.hessian_column(1, h1.data());
+
+    // Hand-written Hessian, contains the exact second derivatives
+    EXPECT_THAT(contains(h0[0], -400 * (b[1] - 3 * sqr(b[0])) + 2), Eq(true));
+    EXPECT_THAT(h0[1], Eq(-400 * b[0]));
+    EXPECT_THAT(h1[0], Eq(-400 * b[0]));
+    EXPECT_THAT(h1[1], Eq(interval(200)));
+}
+
+struct abs_kink {
+    template<class T>
+    T operator()(const std::array<T, 2>& x) const {
+        return abs(x[0]) + sqr(x[1]);
+    }
+};
+
+TEST_F(ATape, givesHessianColumnsOfAbsAtItsKink) {
+    tape t = tape::record<2>(abs_kink());
+    box<2> b({interval(-1, 1), interval(0.5, 1)});
+    tape::sweep s;
+    s.forward(t, b);
+    std::array<interval, 2> h0, h1;
+    s.hessian_column(0, h0.data());
+    s.hessian_column(1, h1.data());
+
+    // Unbounded where abs has no second derivative, exact elsewhere
+    EXPECT_THAT(h0[0], Eq(interval(-INFINITY, INFINITY)));
+    EXPECT_THAT(h0[1], Eq(interval(0)));
+    EXPECT_THAT(h1[0], Eq(interval(0)));
+    EXPECT_THAT(h1[1], Eq(interval(2)));
+}
+
+TEST_F(ATape, enclosesHessianAtPoints) {
+    tape t = tape::record<3>(mixed());
+    box<3> p(std::array<double, 3>{{0.75, 1.5, 0.375}});
+    tape::sweep s;
+    s.forward(t, p);
+    std::array<interval, 3> h[3];
+    for (size_t j = 0; j < 3; ++j) s.hessian_column(j, h[j].data());
+    // Symmetric, and d2/dx0dx1 = x2... terms checked by symmetry and sign
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_THAT(intersect(h[i][j], h[j][i]).lower(),
+                        Not(IsNan())) << i << "," << j;
+            EXPECT_THAT(diam(h[i][j]), Lt(1e-12)) << i << "," << j;
+        }
+    }
+    // d2/dx1^2 = -exp(x0)/x1^2 + cos(x1)
+    double e = -std::exp(0.75) / (1.5 * 1.5) + std::cos(1.5);
+    EXPECT_THAT(h[1][1].lower(), Le(e + 1e-14));
+    EXPECT_THAT(h[1][1].upper(), Ge(e - 1e-14));
+}